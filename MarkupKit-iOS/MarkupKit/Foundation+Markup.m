@@ -13,26 +13,63 @@
 //
 
 #import "Foundation+Markup.h"
+#import "LMPropertyConverter.h"
+
+#import <objc/runtime.h>
+#import <os/lock.h>
+
+@interface LMPropertyAccessor : NSObject
+
+@property (nonatomic, readonly) SEL selector;
+@property (nonatomic, readonly) IMP method;
+@property (nonatomic, readonly) char type;
+
++ (LMPropertyAccessor *)setterForClass:(Class)type key:(NSString *)key;
++ (LMPropertyAccessor *)getterForClass:(Class)type key:(NSString *)key;
+
++ (const LMPropertyConverter *)converterForClass:(Class)type key:(NSString *)key;
+
++ (NSArray<NSString *> *)componentsForKeyPath:(NSString *)keyPath;
+
+- (BOOL)setValue:(id)value forTarget:(id)target;
+- (id)valueForTarget:(id)target;
+
+@end
 
 @implementation NSObject (Markup)
 
 - (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
 {
+    const LMPropertyConverter *converter = [LMPropertyAccessor converterForClass:object_getClass(self) key:key];
+
+    if (converter != NULL) {
+        value = (converter->values == NULL) ? converter->function(self, value) : LMEnumValue(converter->values, value);
+    }
+
     if (value != nil && value != [NSNull null]) {
-        [self setValue:value forKey:key];
+        // Call the resolved setter directly when possible; anything else is left to KVC
+        LMPropertyAccessor *setter = [LMPropertyAccessor setterForClass:object_getClass(self) key:key];
+
+        if (setter == nil || ![setter setValue:value forTarget:self]) {
+            [self setValue:value forKey:key];
+        }
     }
 }
 
 - (void)applyMarkupPropertyValue:(id)value forKeyPath:(NSString *)keyPath
 {
-    NSArray *components = [keyPath componentsSeparatedByString:@"."];
+    NSArray *components = [LMPropertyAccessor componentsForKeyPath:keyPath];
 
     NSUInteger n = [components count];
 
     id target = self;
 
     for (NSUInteger i = 0; i < n - 1; i++) {
-        target = [target valueForKey:[components objectAtIndex:i]];
+        NSString *key = [components objectAtIndex:i];
+
+        LMPropertyAccessor *getter = [LMPropertyAccessor getterForClass:object_getClass(target) key:key];
+
+        target = (getter == nil) ? [target valueForKey:key] : [getter valueForTarget:target];
     }
 
     [target applyMarkupPropertyValue:value forKey:[components objectAtIndex:n - 1]];
@@ -40,6 +77,338 @@
 
 @end
 
+@implementation NSObject (LMPropertyConverter)
+
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
+{
+    return NULL;
+}
+
+@end
+
+@implementation LMPropertyAccessor
+
+static NSMapTable *setters;
+static NSMapTable *getters;
+static NSMapTable *converters;
+
+static NSMutableDictionary<NSString *, NSArray<NSString *> *> *keyPathComponents;
+
+static os_unfair_lock accessorLock = OS_UNFAIR_LOCK_INIT;
+
++ (void)initialize
+{
+    NSPointerFunctionsOptions keyOptions = NSPointerFunctionsOpaqueMemory | NSPointerFunctionsOpaquePersonality;
+
+    setters = [NSMapTable mapTableWithKeyOptions:keyOptions valueOptions:NSPointerFunctionsStrongMemory];
+    getters = [NSMapTable mapTableWithKeyOptions:keyOptions valueOptions:NSPointerFunctionsStrongMemory];
+    converters = [NSMapTable mapTableWithKeyOptions:keyOptions valueOptions:NSPointerFunctionsStrongMemory];
+
+    keyPathComponents = [NSMutableDictionary new];
+}
+
++ (LMPropertyAccessor *)setterForClass:(Class)type key:(NSString *)key
+{
+    return [self accessorForClass:type key:key table:setters setter:YES];
+}
+
++ (LMPropertyAccessor *)getterForClass:(Class)type key:(NSString *)key
+{
+    return [self accessorForClass:type key:key table:getters setter:NO];
+}
+
++ (const LMPropertyConverter *)converterForClass:(Class)type key:(NSString *)key
+{
+    if (type == Nil) {
+        return NULL;
+    }
+
+    os_unfair_lock_lock(&accessorLock);
+
+    NSValue *converter = [[converters objectForKey:type] objectForKey:key];
+
+    os_unfair_lock_unlock(&accessorLock);
+
+    if (converter == nil) {
+        converter = [NSValue valueWithPointer:[type propertyConverterForKey:key]];
+
+        os_unfair_lock_lock(&accessorLock);
+
+        NSMutableDictionary *classConverters = [converters objectForKey:type];
+
+        if (classConverters == nil) {
+            classConverters = [NSMutableDictionary new];
+
+            [converters setObject:classConverters forKey:type];
+        }
+
+        [classConverters setObject:converter forKey:key];
+
+        os_unfair_lock_unlock(&accessorLock);
+    }
+
+    return [converter pointerValue];
+}
+
++ (LMPropertyAccessor *)accessorForClass:(Class)type key:(NSString *)key table:(NSMapTable *)table setter:(BOOL)setter
+{
+    if (type == Nil) {
+        return nil;
+    }
+
+    os_unfair_lock_lock(&accessorLock);
+
+    NSMutableDictionary *accessors = [table objectForKey:type];
+
+    id accessor = [accessors objectForKey:key];
+
+    os_unfair_lock_unlock(&accessorLock);
+
+    if (accessor == nil) {
+        accessor = setter ? [self resolveSetterForClass:type key:key] : [self resolveGetterForClass:type key:key];
+
+        if (accessor == nil) {
+            accessor = [NSNull null];
+        }
+
+        os_unfair_lock_lock(&accessorLock);
+
+        accessors = [table objectForKey:type];
+
+        if (accessors == nil) {
+            accessors = [NSMutableDictionary new];
+
+            [table setObject:accessors forKey:type];
+        }
+
+        [accessors setObject:accessor forKey:key];
+
+        os_unfair_lock_unlock(&accessorLock);
+    }
+
+    return (accessor == [NSNull null]) ? nil : accessor;
+}
+
++ (LMPropertyAccessor *)resolveSetterForClass:(Class)type key:(NSString *)key
+{
+    // Classes that customize key-value coding are always handled by KVC
+    SEL setValueForKey = @selector(setValue:forKey:);
+
+    if ([key length] == 0 || class_getMethodImplementation(type, setValueForKey) != class_getMethodImplementation([NSObject self], setValueForKey)) {
+        return nil;
+    }
+
+    SEL selector = NSSelectorFromString([NSString stringWithFormat:@"set%@%@:",
+        [[key substringToIndex:1] uppercaseString],
+        [key substringFromIndex:1]]);
+
+    Method method = class_getInstanceMethod(type, selector);
+
+    if (method == NULL || method_getNumberOfArguments(method) != 3) {
+        return nil;
+    }
+
+    char encoding[32];
+    method_getArgumentType(method, 2, encoding, sizeof(encoding));
+
+    char argumentType = [self typeForEncoding:encoding];
+
+    if (argumentType == 0 || strchr("@cCsSiIlLqQfdB", argumentType) == NULL) {
+        return nil;
+    }
+
+    return [[LMPropertyAccessor alloc] initWithSelector:selector method:method_getImplementation(method) type:argumentType];
+}
+
++ (LMPropertyAccessor *)resolveGetterForClass:(Class)type key:(NSString *)key
+{
+    SEL valueForKey = @selector(valueForKey:);
+
+    if ([key length] == 0 || class_getMethodImplementation(type, valueForKey) != class_getMethodImplementation([NSObject self], valueForKey)) {
+        return nil;
+    }
+
+    // KVC prefers get<Key> over <key>
+    SEL accessor = NSSelectorFromString([NSString stringWithFormat:@"get%@%@",
+        [[key substringToIndex:1] uppercaseString],
+        [key substringFromIndex:1]]);
+
+    if (class_getInstanceMethod(type, accessor) != NULL) {
+        return nil;
+    }
+
+    SEL selector = NSSelectorFromString(key);
+
+    Method method = class_getInstanceMethod(type, selector);
+
+    if (method == NULL || method_getNumberOfArguments(method) != 2) {
+        return nil;
+    }
+
+    char encoding[32];
+    method_getReturnType(method, encoding, sizeof(encoding));
+
+    // Only object-valued getters are called directly; scalar results need KVC's boxing
+    if ([self typeForEncoding:encoding] != '@') {
+        return nil;
+    }
+
+    return [[LMPropertyAccessor alloc] initWithSelector:selector method:method_getImplementation(method) type:'@'];
+}
+
++ (char)typeForEncoding:(const char *)encoding
+{
+    // Skip type qualifiers such as const, in, and out
+    while (*encoding != 0 && strchr("rnNoORV", *encoding) != NULL) {
+        encoding++;
+    }
+
+    return *encoding;
+}
+
++ (NSArray<NSString *> *)componentsForKeyPath:(NSString *)keyPath
+{
+    os_unfair_lock_lock(&accessorLock);
+
+    NSArray *components = [keyPathComponents objectForKey:keyPath];
+
+    os_unfair_lock_unlock(&accessorLock);
+
+    if (components == nil) {
+        components = [keyPath componentsSeparatedByString:@"."];
+
+        os_unfair_lock_lock(&accessorLock);
+
+        [keyPathComponents setObject:components forKey:keyPath];
+
+        os_unfair_lock_unlock(&accessorLock);
+    }
+
+    return components;
+}
+
+- (instancetype)initWithSelector:(SEL)selector method:(IMP)method type:(char)type
+{
+    self = [super init];
+
+    if (self) {
+        _selector = selector;
+        _method = method;
+        _type = type;
+    }
+
+    return self;
+}
+
+- (BOOL)setValue:(id)value forTarget:(id)target
+{
+    if (_type == '@') {
+        ((void (*)(id, SEL, id))_method)(target, _selector, value);
+
+        return YES;
+    }
+
+    // Unbox scalars the same way KVC does; strings only support the conversions KVC can perform on them
+    BOOL number = [value isKindOfClass:[NSNumber self]];
+
+    if (!number && !([value isKindOfClass:[NSString self]] && strchr("csilqQfdB", _type) != NULL)) {
+        return NO;
+    }
+
+    switch (_type) {
+        case 'c': {
+            ((void (*)(id, SEL, char))_method)(target, _selector, [value charValue]);
+
+            break;
+        }
+
+        case 'C': {
+            ((void (*)(id, SEL, unsigned char))_method)(target, _selector, [value unsignedCharValue]);
+
+            break;
+        }
+
+        case 's': {
+            ((void (*)(id, SEL, short))_method)(target, _selector, [value shortValue]);
+
+            break;
+        }
+
+        case 'S': {
+            ((void (*)(id, SEL, unsigned short))_method)(target, _selector, [value unsignedShortValue]);
+
+            break;
+        }
+
+        case 'i': {
+            ((void (*)(id, SEL, int))_method)(target, _selector, [value intValue]);
+
+            break;
+        }
+
+        case 'I': {
+            ((void (*)(id, SEL, unsigned int))_method)(target, _selector, [value unsignedIntValue]);
+
+            break;
+        }
+
+        case 'l': {
+            ((void (*)(id, SEL, long))_method)(target, _selector, [value longValue]);
+
+            break;
+        }
+
+        case 'L': {
+            ((void (*)(id, SEL, unsigned long))_method)(target, _selector, [value unsignedLongValue]);
+
+            break;
+        }
+
+        case 'q': {
+            ((void (*)(id, SEL, long long))_method)(target, _selector, [value longLongValue]);
+
+            break;
+        }
+
+        case 'Q': {
+            ((void (*)(id, SEL, unsigned long long))_method)(target, _selector, [value unsignedLongLongValue]);
+
+            break;
+        }
+
+        case 'f': {
+            ((void (*)(id, SEL, float))_method)(target, _selector, [value floatValue]);
+
+            break;
+        }
+
+        case 'd': {
+            ((void (*)(id, SEL, double))_method)(target, _selector, [value doubleValue]);
+
+            break;
+        }
+
+        case 'B': {
+            ((void (*)(id, SEL, bool))_method)(target, _selector, [value boolValue]);
+
+            break;
+        }
+
+        default: {
+            return NO;
+        }
+    }
+
+    return YES;
+}
+
+- (id)valueForTarget:(id)target
+{
+    return ((id (*)(id, SEL))_method)(target, _selector);
+}
+
+@end
+
 @implementation NSString (Markup)
 
 - (char)charValue
@@ -66,165 +435,171 @@
 
 @implementation NSNumberFormatter (Markup)
 
-static NSDictionary *numberFormatterStyleValues;
-
-+ (void)initialize
-{
-    numberFormatterStyleValues = @{
-        @"none": @(NSNumberFormatterNoStyle),
-        @"decimal": @(NSNumberFormatterDecimalStyle),
-        @"currency": @(NSNumberFormatterCurrencyStyle),
-        @"percent": @(NSNumberFormatterPercentStyle),
-        @"scientific": @(NSNumberFormatterScientificStyle),
-        @"spellOut": @(NSNumberFormatterSpellOutStyle),
-        @"ordinal": @(NSNumberFormatterOrdinalStyle),
-        @"currencyISOCode": @(NSNumberFormatterCurrencyISOCodeStyle),
-        @"currencyPlural": @(NSNumberFormatterCurrencyPluralStyle),
-        @"currencyAccounting": @(NSNumberFormatterCurrencyAccountingStyle)
-    };
-}
-
-- (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
+static const LMEnumEntry numberFormatterStyleEntries[] = {
+    {"none", NSNumberFormatterNoStyle},
+    {"decimal", NSNumberFormatterDecimalStyle},
+    {"currency", NSNumberFormatterCurrencyStyle},
+    {"percent", NSNumberFormatterPercentStyle},
+    {"scientific", NSNumberFormatterScientificStyle},
+    {"spellOut", NSNumberFormatterSpellOutStyle},
+    {"ordinal", NSNumberFormatterOrdinalStyle},
+    {"currencyISOCode", NSNumberFormatterCurrencyISOCodeStyle},
+    {"currencyPlural", NSNumberFormatterCurrencyPluralStyle},
+    {"currencyAccounting", NSNumberFormatterCurrencyAccountingStyle}
+};
+
+static LMEnumTable numberFormatterStyleValues = LMEnumTableMake(numberFormatterStyleEntries);
+
+static const LMPropertyConverter numberFormatterPropertyConverters[] = {
+    {"numberStyle", &numberFormatterStyleValues, NULL}
+};
+
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
 {
-    if ([key isEqual:@"numberStyle"]) {
-        value = [numberFormatterStyleValues objectForKey:value];
-    }
+    const LMPropertyConverter *converter = LMFindPropertyConverter(numberFormatterPropertyConverters,
+        LMPropertyConverterCount(numberFormatterPropertyConverters), key);
 
-    [super applyMarkupPropertyValue:value forKey:key];
+    return (converter == NULL) ? [super propertyConverterForKey:key] : converter;
 }
 
 @end
 
 @implementation NSDateFormatter (Markup)
 
-static NSDictionary *dateFormatterStyleValues;
+static const LMEnumEntry dateFormatterStyleEntries[] = {
+    {"none", NSDateFormatterNoStyle},
+    {"short", NSDateFormatterShortStyle},
+    {"medium", NSDateFormatterMediumStyle},
+    {"long", NSDateFormatterLongStyle},
+    {"full", NSDateFormatterFullStyle}
+};
 
-+ (void)initialize
-{
-    dateFormatterStyleValues = @{
-        @"none": @(NSDateFormatterNoStyle),
-        @"short": @(NSDateFormatterShortStyle),
-        @"medium": @(NSDateFormatterMediumStyle),
-        @"long": @(NSDateFormatterLongStyle),
-        @"full": @(NSDateFormatterFullStyle)
-    };
-}
+static LMEnumTable dateFormatterStyleValues = LMEnumTableMake(dateFormatterStyleEntries);
 
-- (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
+static const LMPropertyConverter dateFormatterPropertyConverters[] = {
+    {"dateStyle", &dateFormatterStyleValues, NULL},
+    {"timeStyle", &dateFormatterStyleValues, NULL}
+};
+
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
 {
-    if ([key isEqual:@"dateStyle"] || [key isEqual:@"timeStyle"]) {
-        value = [dateFormatterStyleValues objectForKey:value];
-    }
+    const LMPropertyConverter *converter = LMFindPropertyConverter(dateFormatterPropertyConverters,
+        LMPropertyConverterCount(dateFormatterPropertyConverters), key);
 
-    [super applyMarkupPropertyValue:value forKey:key];
+    return (converter == NULL) ? [super propertyConverterForKey:key] : converter;
 }
 
 @end
 
 @implementation NSPersonNameComponentsFormatter (Markup)
 
-static NSDictionary *personNameComponentsFormatterStyleValues;
+static const LMEnumEntry personNameComponentsFormatterStyleEntries[] = {
+    {"short", NSPersonNameComponentsFormatterStyleShort},
+    {"medium", NSPersonNameComponentsFormatterStyleMedium},
+    {"long", NSPersonNameComponentsFormatterStyleLong}
+};
 
-+ (void)initialize
-{
-    personNameComponentsFormatterStyleValues = @{
-        @"short": @(NSPersonNameComponentsFormatterStyleShort),
-        @"medium": @(NSPersonNameComponentsFormatterStyleMedium),
-        @"long": @(NSPersonNameComponentsFormatterStyleLong)
-    };
-}
+static LMEnumTable personNameComponentsFormatterStyleValues = LMEnumTableMake(personNameComponentsFormatterStyleEntries);
 
-- (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
+static const LMPropertyConverter personNameComponentsFormatterPropertyConverters[] = {
+    {"style", &personNameComponentsFormatterStyleValues, NULL}
+};
+
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
 {
-    if ([key isEqual:@"style"]) {
-        value = [personNameComponentsFormatterStyleValues objectForKey:value];
-    }
+    const LMPropertyConverter *converter = LMFindPropertyConverter(personNameComponentsFormatterPropertyConverters,
+        LMPropertyConverterCount(personNameComponentsFormatterPropertyConverters), key);
 
-    [super applyMarkupPropertyValue:value forKey:key];
+    return (converter == NULL) ? [super propertyConverterForKey:key] : converter;
 }
 
 @end
 
 @implementation NSByteCountFormatter (Markup)
 
-static NSDictionary *byteCountFormatterUnitValues;
-static NSDictionary *byteCountFormatterCountStyleValues;
-
-+ (void)initialize
+static const LMEnumEntry byteCountFormatterUnitEntries[] = {
+    {"useBytes", NSByteCountFormatterUseBytes},
+    {"useKB", NSByteCountFormatterUseKB},
+    {"useMB", NSByteCountFormatterUseMB},
+    {"useGB", NSByteCountFormatterUseGB},
+    {"useTB", NSByteCountFormatterUseTB},
+    {"usePB", NSByteCountFormatterUsePB},
+    {"useEB", NSByteCountFormatterUseEB},
+    {"useZB", NSByteCountFormatterUseZB},
+    {"useYBOrHigher", NSByteCountFormatterUseYBOrHigher},
+    {"useAll", NSByteCountFormatterUseAll}
+};
+
+static LMEnumTable byteCountFormatterUnitValues = LMEnumTableMake(byteCountFormatterUnitEntries);
+
+static const LMEnumEntry byteCountFormatterCountStyleEntries[] = {
+    {"file", NSByteCountFormatterCountStyleFile},
+    {"memory", NSByteCountFormatterCountStyleMemory},
+    {"decimal", NSByteCountFormatterCountStyleDecimal},
+    {"binary", NSByteCountFormatterCountStyleBinary}
+};
+
+static LMEnumTable byteCountFormatterCountStyleValues = LMEnumTableMake(byteCountFormatterCountStyleEntries);
+
+static id LMByteCountFormatterUnitsValue(id object, id value)
 {
-    byteCountFormatterUnitValues = @{
-        @"useBytes": @(NSByteCountFormatterUseBytes),
-        @"useKB": @(NSByteCountFormatterUseKB),
-        @"useMB": @(NSByteCountFormatterUseMB),
-        @"useGB": @(NSByteCountFormatterUseGB),
-        @"useTB": @(NSByteCountFormatterUseTB),
-        @"usePB": @(NSByteCountFormatterUsePB),
-        @"useEB": @(NSByteCountFormatterUseEB),
-        @"useZB": @(NSByteCountFormatterUseZB),
-        @"useYBOrHigher": @(NSByteCountFormatterUseYBOrHigher),
-        @"useAll": @(NSByteCountFormatterUseAll)
-    };
-
-    byteCountFormatterCountStyleValues = @{
-        @"file": @(NSByteCountFormatterCountStyleFile),
-        @"memory": @(NSByteCountFormatterCountStyleMemory),
-        @"decimal": @(NSByteCountFormatterCountStyleDecimal),
-        @"binary": @(NSByteCountFormatterCountStyleBinary)
-    };
-}
+    NSArray *components = [value componentsSeparatedByString:@","];
 
-- (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
-{
-    if ([key isEqual:@"allowedUnits"]) {
-        NSArray *components = [value componentsSeparatedByString:@","];
+    NSByteCountFormatterUnits byteCountFormatterUnits = 0;
 
-        NSByteCountFormatterUnits byteCountFormatterUnits = 0;
+    for (NSString *component in components) {
+        NSString *name = [component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
 
-        for (NSString *component in components) {
-            NSString *name = [component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+        byteCountFormatterUnits |= [LMEnumValue(&byteCountFormatterUnitValues, name) unsignedIntegerValue];
+    }
 
-            byteCountFormatterUnits |= [[byteCountFormatterUnitValues objectForKey:name] unsignedIntegerValue];
-        }
+    return @(byteCountFormatterUnits);
+}
 
-        value = @(byteCountFormatterUnits);
-    } else if ([key isEqual:@"countStyle"]) {
-        value = [byteCountFormatterCountStyleValues objectForKey:value];
-    }
+static const LMPropertyConverter byteCountFormatterPropertyConverters[] = {
+    {"allowedUnits", NULL, LMByteCountFormatterUnitsValue},
+    {"countStyle", &byteCountFormatterCountStyleValues, NULL}
+};
 
-    [super applyMarkupPropertyValue:value forKey:key];
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
+{
+    const LMPropertyConverter *converter = LMFindPropertyConverter(byteCountFormatterPropertyConverters,
+        LMPropertyConverterCount(byteCountFormatterPropertyConverters), key);
+
+    return (converter == NULL) ? [super propertyConverterForKey:key] : converter;
 }
 
 @end
 
 @implementation NSMeasurementFormatter (Markup)
 
-static NSDictionary *measurementFormatterUnitOptionValues;
-static NSDictionary *formattingUnitStyles;
+static const LMEnumEntry measurementFormatterUnitOptionEntries[] = {
+    {"providedUnit", NSMeasurementFormatterUnitOptionsProvidedUnit},
+    {"naturalScale", NSMeasurementFormatterUnitOptionsNaturalScale},
+    {"temperatureWithoutUnit", NSMeasurementFormatterUnitOptionsTemperatureWithoutUnit}
+};
 
-+ (void)initialize
-{
-    measurementFormatterUnitOptionValues = @{
-        @"providedUnit": @(NSMeasurementFormatterUnitOptionsProvidedUnit),
-        @"naturalScale": @(NSMeasurementFormatterUnitOptionsNaturalScale),
-        @"temperatureWithoutUnit": @(NSMeasurementFormatterUnitOptionsTemperatureWithoutUnit)
-    };
+static LMEnumTable measurementFormatterUnitOptionValues = LMEnumTableMake(measurementFormatterUnitOptionEntries);
 
-    formattingUnitStyles = @{
-        @"short": @(NSFormattingUnitStyleShort),
-        @"medium": @(NSFormattingUnitStyleMedium),
-        @"long": @(NSFormattingUnitStyleLong)
-    };
-}
+static const LMEnumEntry formattingUnitStyleEntries[] = {
+    {"short", NSFormattingUnitStyleShort},
+    {"medium", NSFormattingUnitStyleMedium},
+    {"long", NSFormattingUnitStyleLong}
+};
 
-- (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
+static LMEnumTable formattingUnitStyles = LMEnumTableMake(formattingUnitStyleEntries);
+
+static const LMPropertyConverter measurementFormatterPropertyConverters[] = {
+    {"unitOptions", &measurementFormatterUnitOptionValues, NULL},
+    {"unitStyle", &formattingUnitStyles, NULL}
+};
+
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
 {
-    if ([key isEqual:@"unitOptions"]) {
-        value = [measurementFormatterUnitOptionValues objectForKey:value];
-    } else if ([key isEqual:@"unitStyle"]) {
-        value = [formattingUnitStyles objectForKey:value];
-    }
+    const LMPropertyConverter *converter = LMFindPropertyConverter(measurementFormatterPropertyConverters,
+        LMPropertyConverterCount(measurementFormatterPropertyConverters), key);
 
-    [super applyMarkupPropertyValue:value forKey:key];
+    return (converter == NULL) ? [super propertyConverterForKey:key] : converter;
 }
 
 @end
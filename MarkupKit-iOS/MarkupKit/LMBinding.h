@@ -0,0 +1,108 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Stores an owner's bindings and observes the owner on their behalf. Bindings are kept in
+ * parallel arrays indexed by slot; compiled expressions, formatter specifiers, and target key
+ * paths are interned in a process-wide pool and referenced by index. Each distinct key path
+ * is observed once, and changes are delivered to the bindings that depend on it.
+ */
+@interface LMBindingHub : NSObject
+
+/**
+ * Defers updates to coalescing bindings until a matching call to <code>endDeferringUpdates</code>.
+ * Calls may be nested.
+ */
++ (void)beginDeferringUpdates;
+
+/**
+ * Ends a deferral. Pending updates are applied when the outermost deferral ends.
+ */
++ (void)endDeferringUpdates;
+
+/**
+ * The number of times a binding has been updated.
+ */
++ (NSUInteger)updateCount;
+
+/**
+ * The number of changes that were absorbed by an update that was already pending.
+ */
++ (NSUInteger)coalescedUpdateCount;
+
+/**
+ * The number of updates that were skipped because the bound view was not visible.
+ */
++ (NSUInteger)suspendedUpdateCount;
+
+/**
+ * The number of writes that were skipped because the value was unchanged.
+ */
++ (NSUInteger)unchangedValueCount;
+
+/**
+ * Resumes the suspended bindings of a view.
+ *
+ * @param view The view whose bindings will be resumed.
+ */
++ (void)resumeBindingsForView:(UIView *)view;
+
+/**
+ * Resumes the suspended bindings of a view or any of its descendants.
+ *
+ * @param view The view whose bindings will be resumed.
+ */
++ (void)resumeBindingsInView:(UIView *)view;
+
+- (instancetype)initWithOwner:(id)owner;
+
+/**
+ * The number of bindings in the hub.
+ */
+@property (nonatomic, readonly) NSUInteger bindingCount;
+
+/**
+ * The number of bindings whose views have been deallocated but that have not yet been removed.
+ */
+@property (nonatomic, readonly) NSUInteger deadBindingCount;
+
+/**
+ * Adds a binding and applies its initial value.
+ *
+ * @param expression The binding expression, optionally followed by a formatter specifier.
+ * @param view The target view.
+ * @param keyPath The target key path.
+ */
+- (void)bind:(NSString *)expression toView:(UIView *)view withKeyPath:(NSString *)keyPath;
+
+/**
+ * Sets the value of an owner property and retargets the bindings that depend on it.
+ *
+ * @param key The property key.
+ * @param source The new value.
+ */
+- (void)rebindKey:(NSString *)key toSource:(nullable id)source;
+
+/**
+ * Removes all bindings and observers.
+ */
+- (void)removeAllBindings;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,1194 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#import "LMBinding.h"
+#import "LMBindingExpression.h"
+#import "LMPageView.h"
+#import "UIKit+Markup.h"
+
+#import <objc/runtime.h>
+#import <os/lock.h>
+
+#define LMNoFormatter UINT32_MAX
+
+@interface LMFormatterSpecifier : NSObject
+
+@property (nonatomic, readonly) NSString *name;
+@property (nonatomic, readonly) NSDictionary<NSString *, id> *arguments;
+
+@property (nonatomic, readonly) NSString *key;
+
+@end
+
+@implementation LMFormatterSpecifier
+
+- (instancetype)initWithString:(NSString *)string
+{
+    self = [super init];
+
+    if (self) {
+        NSArray *formatComponents = [string componentsSeparatedByString:@";"];
+
+        _name = [formatComponents[0] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+
+        NSMutableDictionary *arguments = [NSMutableDictionary new];
+
+        for (NSUInteger i = 1, n = [formatComponents count]; i < n; i++) {
+            NSArray *argumentComponents = [formatComponents[i] componentsSeparatedByString:@"="];
+
+            if ([argumentComponents count] > 1) {
+                NSString *key = [argumentComponents[0] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+                NSString *value = [argumentComponents[1] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+
+                [arguments setObject:value forKey:key];
+            }
+        }
+
+        _arguments = [arguments copy];
+
+        // Arguments are sorted so that equivalent specifiers share a formatter
+        NSMutableString *key = [NSMutableString stringWithString:_name];
+
+        for (NSString *argument in [[arguments allKeys] sortedArrayUsingSelector:@selector(compare:)]) {
+            [key appendFormat:@";%@=%@", argument, [arguments objectForKey:argument]];
+        }
+
+        _key = [key copy];
+    }
+
+    return self;
+}
+
+@end
+
+@interface LMCompiledBinding : NSObject
+
+@property (nonatomic, readonly) LMBindingExpression *expression;
+@property (nonatomic, readonly) NSArray<NSString *> *keyPaths;
+
+@property (nonatomic, readonly) uint32_t formatterIndex;
+
+@end
+
+@implementation LMCompiledBinding
+
+- (instancetype)initWithExpression:(LMBindingExpression *)expression formatterIndex:(uint32_t)formatterIndex
+{
+    self = [super init];
+
+    if (self) {
+        _expression = expression;
+
+        _keyPaths = [_expression keyPaths];
+
+        _formatterIndex = formatterIndex;
+    }
+
+    return self;
+}
+
+@end
+
+// Binding state that is shared by all owners is interned and referenced by index
+static NSMutableArray<LMCompiledBinding *> *compiledBindings;
+static NSMutableDictionary<NSString *, NSNumber *> *compiledBindingIndices;
+
+static NSMutableArray<LMFormatterSpecifier *> *formatterSpecifiers;
+static NSMutableDictionary<NSString *, NSNumber *> *formatterSpecifierIndices;
+
+static NSMutableArray<NSString *> *targetKeyPaths;
+static NSMutableDictionary<NSString *, NSNumber *> *targetKeyPathIndices;
+
+static os_unfair_lock poolLock = OS_UNFAIR_LOCK_INIT;
+
+static uint32_t LMInternCompiledBinding(NSString *string)
+{
+    os_unfair_lock_lock(&poolLock);
+
+    NSNumber *index = [compiledBindingIndices objectForKey:string];
+
+    os_unfair_lock_unlock(&poolLock);
+
+    if (index != nil) {
+        return [index unsignedIntValue];
+    }
+
+    // Expressions are compiled outside of the lock, since invalid expressions raise
+    NSArray *expressionComponents = [string componentsSeparatedByString:@"::"];
+
+    LMBindingExpression *expression = [[LMBindingExpression alloc] initWithString:expressionComponents[0]];
+
+    LMFormatterSpecifier *formatterSpecifier = nil;
+
+    if ([expressionComponents count] > 1) {
+        formatterSpecifier = [[LMFormatterSpecifier alloc] initWithString:expressionComponents[1]];
+    }
+
+    os_unfair_lock_lock(&poolLock);
+
+    // Another thread may have interned the same expression in the meantime
+    index = [compiledBindingIndices objectForKey:string];
+
+    if (index == nil) {
+        uint32_t formatterIndex = LMNoFormatter;
+
+        if (formatterSpecifier != nil) {
+            NSNumber *specifierIndex = [formatterSpecifierIndices objectForKey:[formatterSpecifier key]];
+
+            if (specifierIndex == nil) {
+                specifierIndex = @([formatterSpecifiers count]);
+
+                [formatterSpecifiers addObject:formatterSpecifier];
+                [formatterSpecifierIndices setObject:specifierIndex forKey:[formatterSpecifier key]];
+            }
+
+            formatterIndex = [specifierIndex unsignedIntValue];
+        }
+
+        index = @([compiledBindings count]);
+
+        [compiledBindings addObject:[[LMCompiledBinding alloc] initWithExpression:expression formatterIndex:formatterIndex]];
+        [compiledBindingIndices setObject:index forKey:string];
+    }
+
+    os_unfair_lock_unlock(&poolLock);
+
+    return [index unsignedIntValue];
+}
+
+static LMCompiledBinding *LMCompiledBindingAtIndex(uint32_t index)
+{
+    os_unfair_lock_lock(&poolLock);
+
+    LMCompiledBinding *compiledBinding = [compiledBindings objectAtIndex:index];
+
+    os_unfair_lock_unlock(&poolLock);
+
+    return compiledBinding;
+}
+
+static LMFormatterSpecifier *LMFormatterSpecifierAtIndex(uint32_t index)
+{
+    os_unfair_lock_lock(&poolLock);
+
+    LMFormatterSpecifier *formatterSpecifier = [formatterSpecifiers objectAtIndex:index];
+
+    os_unfair_lock_unlock(&poolLock);
+
+    return formatterSpecifier;
+}
+
+static uint32_t LMInternTargetKeyPath(NSString *keyPath)
+{
+    os_unfair_lock_lock(&poolLock);
+
+    NSNumber *index = [targetKeyPathIndices objectForKey:keyPath];
+
+    if (index == nil) {
+        index = @([targetKeyPaths count]);
+
+        [targetKeyPaths addObject:keyPath];
+        [targetKeyPathIndices setObject:index forKey:keyPath];
+    }
+
+    os_unfair_lock_unlock(&poolLock);
+
+    return [index unsignedIntValue];
+}
+
+static NSString *LMTargetKeyPathAtIndex(uint32_t index)
+{
+    os_unfair_lock_lock(&poolLock);
+
+    NSString *keyPath = [targetKeyPaths objectAtIndex:index];
+
+    os_unfair_lock_unlock(&poolLock);
+
+    return keyPath;
+}
+
+@interface LMKeyPathNode : NSObject
+
+@property (nonatomic, readonly) NSString *key;
+
+@property (nonatomic, readonly) NSMutableIndexSet *slots;
+@property (nonatomic, readonly) NSMutableDictionary<NSString *, NSMutableIndexSet *> *dependentKeyPaths;
+
+@property (nonatomic) id target;
+
+@end
+
+@implementation LMKeyPathNode
+
+- (instancetype)initWithKey:(NSString *)key
+{
+    self = [super init];
+
+    if (self) {
+        _key = key;
+
+        _slots = [NSMutableIndexSet new];
+        _dependentKeyPaths = [NSMutableDictionary new];
+    }
+
+    return self;
+}
+
+@end
+
+@interface LMFormattedValueKey : NSObject <NSCopying>
+
+- (instancetype)initWithGeneration:(NSUInteger)generation formatterKey:(id)formatterKey value:(id)value;
+
+@end
+
+@implementation LMFormattedValueKey
+{
+    NSUInteger _generation;
+
+    id _formatterKey;
+    id _value;
+}
+
+- (instancetype)initWithGeneration:(NSUInteger)generation formatterKey:(id)formatterKey value:(id)value
+{
+    self = [super init];
+
+    if (self) {
+        _generation = generation;
+
+        _formatterKey = formatterKey;
+        _value = value;
+    }
+
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    return self;
+}
+
+- (NSUInteger)hash
+{
+    return [_value hash] ^ [_formatterKey hash] ^ _generation;
+}
+
+- (BOOL)isEqual:(id)object
+{
+    if (![object isKindOfClass:[LMFormattedValueKey self]]) {
+        return NO;
+    }
+
+    LMFormattedValueKey *key = object;
+
+    return _generation == key->_generation && [_formatterKey isEqual:key->_formatterKey] && [_value isEqual:key->_value];
+}
+
+@end
+
+static NSString *LMSplitKeyPath(NSString *keyPath, NSString **dependentKeyPath)
+{
+    // Key paths are observed on the owner by their first component, and the remainder is observed on
+    // the component's value, so bindings that share a prefix are registered and updated together
+    NSRange range = [keyPath rangeOfString:@"."];
+
+    if (range.location != NSNotFound && [keyPath rangeOfString:@"@"].location == NSNotFound) {
+        *dependentKeyPath = [keyPath substringFromIndex:range.location + 1];
+
+        return [keyPath substringToIndex:range.location];
+    } else {
+        *dependentKeyPath = nil;
+
+        return keyPath;
+    }
+}
+
+static BOOL LMIsCollection(id value)
+{
+    // Collections do not support observation of their elements' properties
+    return [value isKindOfClass:[NSArray self]] || [value isKindOfClass:[NSSet self]] || [value isKindOfClass:[NSOrderedSet self]];
+}
+
+static BOOL LMIsVisible(UIView *view)
+{
+    if ([view window] == nil) {
+        return NO;
+    }
+
+    // Pages of a page view remain in the window when they are scrolled out of view
+    for (UIView *superview = [view superview]; superview != nil; view = superview, superview = [view superview]) {
+        if ([superview isKindOfClass:[LMPageView self]] && !CGRectIntersectsRect([view frame], [superview bounds])) {
+            return NO;
+        }
+    }
+
+    return YES;
+}
+
+static BOOL LMIsImmutableValue(id value)
+{
+    // Only values whose copies are immutable are remembered; other objects may have changed in place
+    return [value isKindOfClass:[NSString self]] || [value isKindOfClass:[NSValue self]]
+        || [value isKindOfClass:[NSDate self]] || [value isKindOfClass:[NSAttributedString self]];
+}
+
+typedef NS_OPTIONS(uint8_t, LMBindingFlags) {
+    LMBindingActive = 1 << 0,
+    LMBindingPending = 1 << 1,
+    LMBindingSuspended = 1 << 2,
+    LMBindingWritesUnchangedValues = 1 << 3
+};
+
+@implementation LMBindingHub
+{
+    // Hubs are owned by their owners, and bindings are released while the owner is deallocating,
+    // when a weak reference would already be nil
+    __unsafe_unretained id _owner;
+
+    BOOL _coalescesUpdates;
+    BOOL _suspendsOffscreenBindings;
+    BOOL _formatsAsynchronously;
+    BOOL _providesFormatters;
+
+    // Binding table; the slots of removed bindings are reused
+    NSUInteger _count;
+    NSUInteger _capacity;
+
+    NSPointerArray *_views;
+    NSPointerArray *_values;
+    NSPointerArray *_formatOperations;
+
+    uint32_t *_compiledBindingIndices;
+    uint32_t *_keyPathIndices;
+    uint32_t *_formatterIndices;
+
+    LMBindingFlags *_flags;
+
+    NSMutableIndexSet *_freeSlots;
+
+    NSMutableDictionary<NSString *, LMKeyPathNode *> *_nodes;
+
+    LMKeyPathNode *_rebindingNode;
+
+    NSMutableDictionary<NSNumber *, id> *_formatters;
+    NSMutableDictionary<NSNumber *, id> *_queueFormatters;
+    NSUInteger _formatterGeneration;
+}
+
+static NSMutableDictionary<NSString *, id> *sharedFormatters;
+static NSMutableDictionary<NSString *, id> *sharedQueueFormatters;
+static NSUInteger formatterGeneration = 1;
+
+static os_unfair_lock formatterLock = OS_UNFAIR_LOCK_INIT;
+
+static IMP defaultFormatterWithName;
+
+static NSOperationQueue *formatQueue;
+static NSCache<LMFormattedValueKey *, NSString *> *formattedValues;
+
+static NSMapTable<id, LMBindingHub *> *pendingHubs;
+static NSUInteger deferralDepth;
+
+static CFRunLoopObserverRef runLoopObserver;
+
+static NSMapTable<UIView *, NSHashTable<LMBindingHub *> *> *suspendedHubs;
+
+static NSUInteger updateCount;
+static NSUInteger coalescedUpdateCount;
+static NSUInteger suspendedUpdateCount;
+static NSUInteger unchangedValueCount;
+
++ (void)initialize
+{
+    compiledBindings = [NSMutableArray new];
+    compiledBindingIndices = [NSMutableDictionary new];
+
+    formatterSpecifiers = [NSMutableArray new];
+    formatterSpecifierIndices = [NSMutableDictionary new];
+
+    targetKeyPaths = [NSMutableArray new];
+    targetKeyPathIndices = [NSMutableDictionary new];
+
+    sharedFormatters = [NSMutableDictionary new];
+    sharedQueueFormatters = [NSMutableDictionary new];
+
+    formatQueue = [NSOperationQueue new];
+
+    [formatQueue setName:@"org.markupkit.MarkupKit.formatting"];
+    [formatQueue setMaxConcurrentOperationCount:1];
+    [formatQueue setQualityOfService:NSQualityOfServiceUserInitiated];
+
+    formattedValues = [NSCache new];
+
+    // Owners and views are compared by identity, since they may override isEqual:
+    pendingHubs = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+        valueOptions:NSPointerFunctionsStrongMemory];
+
+    suspendedHubs = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+        valueOptions:NSPointerFunctionsStrongMemory];
+
+    defaultFormatterWithName = class_getMethodImplementation([UIResponder self], @selector(formatterWithName:arguments:));
+
+    // Formatters capture the locale and time zone in effect when they are created
+    NSNotificationCenter *notificationCenter = [NSNotificationCenter defaultCenter];
+
+    for (NSNotificationName name in @[NSCurrentLocaleDidChangeNotification, NSSystemTimeZoneDidChangeNotification]) {
+        [notificationCenter addObserver:self selector:@selector(flushFormatters:) name:name object:nil];
+    }
+}
+
++ (void)flushFormatters:(NSNotification *)notification
+{
+    os_unfair_lock_lock(&formatterLock);
+
+    [sharedFormatters removeAllObjects];
+    [sharedQueueFormatters removeAllObjects];
+
+    formatterGeneration++;
+
+    [formattedValues removeAllObjects];
+
+    os_unfair_lock_unlock(&formatterLock);
+}
+
++ (void)beginDeferringUpdates
+{
+    deferralDepth++;
+}
+
++ (void)endDeferringUpdates
+{
+    // Pending updates are applied before the outermost deferral ends, so their values are formatted synchronously
+    if (deferralDepth == 1) {
+        @try {
+            [self flushPendingUpdates];
+        }
+        @finally {
+            deferralDepth--;
+        }
+    } else {
+        deferralDepth--;
+    }
+}
+
++ (NSUInteger)updateCount
+{
+    return updateCount;
+}
+
++ (NSUInteger)coalescedUpdateCount
+{
+    return coalescedUpdateCount;
+}
+
++ (NSUInteger)suspendedUpdateCount
+{
+    return suspendedUpdateCount;
+}
+
++ (NSUInteger)unchangedValueCount
+{
+    return unchangedValueCount;
+}
+
++ (void)schedule:(LMBindingHub *)hub
+{
+    if ([pendingHubs objectForKey:hub->_owner] == nil) {
+        [pendingHubs setObject:hub forKey:hub->_owner];
+    }
+
+    [self addRunLoopObserver];
+}
+
++ (void)addRunLoopObserver
+{
+    if (runLoopObserver == NULL) {
+        // Suspended bindings whose views have become visible are resumed, and pending bindings are flushed,
+        // before Core Animation commits the current transaction
+        runLoopObserver = CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault, kCFRunLoopBeforeWaiting | kCFRunLoopExit, true, 0, ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+            if (deferralDepth == 0) {
+                [LMBindingHub resumeVisibleBindings];
+                [LMBindingHub flushPendingUpdates];
+            }
+        });
+
+        CFRunLoopAddObserver(CFRunLoopGetMain(), runLoopObserver, kCFRunLoopCommonModes);
+    }
+}
+
++ (void)flushPendingUpdates
+{
+    // Updates may cause additional bindings to become pending
+    while ([pendingHubs count] > 0) {
+        NSMapTable *hubs = [pendingHubs copy];
+
+        [pendingHubs removeAllObjects];
+
+        for (id owner in hubs) {
+            [[hubs objectForKey:owner] updatePendingBindings];
+        }
+    }
+}
+
++ (void)suspendView:(UIView *)view hub:(LMBindingHub *)hub
+{
+    NSHashTable *hubs = [suspendedHubs objectForKey:view];
+
+    if (hubs == nil) {
+        hubs = [NSHashTable weakObjectsHashTable];
+
+        [suspendedHubs setObject:hubs forKey:view];
+    }
+
+    [hubs addObject:hub];
+
+    [self addRunLoopObserver];
+}
+
++ (void)resumeVisibleBindings
+{
+    if ([suspendedHubs count] == 0) {
+        return;
+    }
+
+    // UIKit does not notify observers when a view moves into a window, so suspended views are checked
+    // on each pass of the run loop
+    for (UIView *suspendedView in [[suspendedHubs keyEnumerator] allObjects]) {
+        if (LMIsVisible(suspendedView)) {
+            [self resumeBindingsForView:suspendedView];
+        }
+    }
+}
+
++ (void)resumeBindingsForView:(UIView *)view
+{
+    if ([suspendedHubs count] == 0) {
+        return;
+    }
+
+    NSHashTable *hubs = [suspendedHubs objectForKey:view];
+
+    if (hubs != nil) {
+        [suspendedHubs removeObjectForKey:view];
+
+        for (LMBindingHub *hub in hubs) {
+            [hub resumeSuspendedBindingsForView:view];
+        }
+    }
+}
+
++ (void)resumeBindingsInView:(UIView *)view
+{
+    if ([suspendedHubs count] == 0) {
+        return;
+    }
+
+    for (UIView *suspendedView in [[suspendedHubs keyEnumerator] allObjects]) {
+        if ([suspendedView isDescendantOfView:view]) {
+            [self resumeBindingsForView:suspendedView];
+        }
+    }
+}
+
+- (instancetype)initWithOwner:(id)owner
+{
+    self = [super init];
+
+    if (self) {
+        _owner = owner;
+
+        _coalescesUpdates = [owner coalescesBindingUpdates];
+        _suspendsOffscreenBindings = [owner suspendsOffscreenBindings];
+        _formatsAsynchronously = [owner formatsBindingValuesAsynchronously];
+
+        // Formatters provided by the default implementation are never exposed, so they can be shared
+        // across owners; owners that provide their own formatters are asked once per specifier
+        _providesFormatters = (class_getMethodImplementation(object_getClass(owner), @selector(formatterWithName:arguments:)) != defaultFormatterWithName);
+
+        _views = [NSPointerArray weakObjectsPointerArray];
+        _values = [NSPointerArray strongObjectsPointerArray];
+        _formatOperations = [NSPointerArray strongObjectsPointerArray];
+
+        _freeSlots = [NSMutableIndexSet new];
+
+        _nodes = [NSMutableDictionary new];
+
+        _formatters = [NSMutableDictionary new];
+        _queueFormatters = [NSMutableDictionary new];
+    }
+
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_compiledBindingIndices);
+    free(_keyPathIndices);
+    free(_formatterIndices);
+
+    free(_flags);
+}
+
+- (NSUInteger)bindingCount
+{
+    return _count - [_freeSlots count];
+}
+
+- (NSUInteger)deadBindingCount
+{
+    NSUInteger deadBindingCount = 0;
+
+    for (NSUInteger slot = 0; slot < _count; slot++) {
+        if ((_flags[slot] & LMBindingActive) && [_views pointerAtIndex:slot] == NULL) {
+            deadBindingCount++;
+        }
+    }
+
+    return deadBindingCount;
+}
+
+- (NSUInteger)allocateSlot
+{
+    NSUInteger slot = [_freeSlots firstIndex];
+
+    if (slot != NSNotFound) {
+        [_freeSlots removeIndex:slot];
+
+        return slot;
+    }
+
+    if (_count == _capacity) {
+        _capacity = (_capacity == 0) ? 8 : _capacity * 2;
+
+        _compiledBindingIndices = realloc(_compiledBindingIndices, _capacity * sizeof(uint32_t));
+        _keyPathIndices = realloc(_keyPathIndices, _capacity * sizeof(uint32_t));
+        _formatterIndices = realloc(_formatterIndices, _capacity * sizeof(uint32_t));
+
+        _flags = realloc(_flags, _capacity * sizeof(LMBindingFlags));
+    }
+
+    [_views addPointer:NULL];
+    [_values addPointer:NULL];
+    [_formatOperations addPointer:NULL];
+
+    return _count++;
+}
+
+- (void)bind:(NSString *)expression toView:(UIView *)view withKeyPath:(NSString *)keyPath
+{
+    uint32_t compiledBindingIndex = LMInternCompiledBinding(expression);
+
+    LMCompiledBinding *compiledBinding = LMCompiledBindingAtIndex(compiledBindingIndex);
+
+    NSUInteger slot = [self allocateSlot];
+
+    [_views replacePointerAtIndex:slot withPointer:(__bridge void *)view];
+
+    _compiledBindingIndices[slot] = compiledBindingIndex;
+    _keyPathIndices[slot] = LMInternTargetKeyPath(keyPath);
+    _formatterIndices[slot] = [compiledBinding formatterIndex];
+
+    _flags[slot] = LMBindingActive;
+
+    if ([view writesUnchangedBindingValueForKeyPath:keyPath]) {
+        _flags[slot] |= LMBindingWritesUnchangedValues;
+    }
+
+    for (NSString *observedKeyPath in [compiledBinding keyPaths]) {
+        NSString *dependentKeyPath;
+        NSString *key = LMSplitKeyPath(observedKeyPath, &dependentKeyPath);
+
+        LMKeyPathNode *node = [_nodes objectForKey:key];
+
+        if (node == nil) {
+            node = [[LMKeyPathNode alloc] initWithKey:key];
+
+            [_nodes setObject:node forKey:key];
+
+            [_owner addObserver:self forKeyPath:key options:0 context:(__bridge void *)node];
+
+            [node setTarget:[_owner valueForKeyPath:key]];
+        }
+
+        [[node slots] addIndex:slot];
+
+        if (dependentKeyPath != nil) {
+            NSMutableIndexSet *dependentSlots = [[node dependentKeyPaths] objectForKey:dependentKeyPath];
+
+            if (dependentSlots == nil) {
+                dependentSlots = [NSMutableIndexSet new];
+
+                [[node dependentKeyPaths] setObject:dependentSlots forKey:dependentKeyPath];
+
+                [self observe:[node target] keyPath:dependentKeyPath node:node];
+            }
+
+            [dependentSlots addIndex:slot];
+        }
+    }
+
+    [self setNeedsUpdate:slot];
+}
+
+- (void)removeBindingAtSlot:(NSUInteger)slot
+{
+    LMCompiledBinding *compiledBinding = LMCompiledBindingAtIndex(_compiledBindingIndices[slot]);
+
+    for (NSString *observedKeyPath in [compiledBinding keyPaths]) {
+        NSString *dependentKeyPath;
+        NSString *key = LMSplitKeyPath(observedKeyPath, &dependentKeyPath);
+
+        LMKeyPathNode *node = [_nodes objectForKey:key];
+
+        if (node == nil) {
+            continue;
+        }
+
+        if (dependentKeyPath != nil) {
+            NSMutableIndexSet *dependentSlots = [[node dependentKeyPaths] objectForKey:dependentKeyPath];
+
+            [dependentSlots removeIndex:slot];
+
+            if (dependentSlots != nil && [dependentSlots count] == 0) {
+                [self unobserve:[node target] keyPath:dependentKeyPath node:node];
+
+                [[node dependentKeyPaths] removeObjectForKey:dependentKeyPath];
+            }
+        }
+
+        [[node slots] removeIndex:slot];
+
+        if ([[node slots] count] == 0) {
+            [self removeNode:node];
+        }
+    }
+
+    [self cancelFormatOperationAtSlot:slot];
+
+    [_views replacePointerAtIndex:slot withPointer:NULL];
+    [_values replacePointerAtIndex:slot withPointer:NULL];
+
+    _flags[slot] = 0;
+
+    [_freeSlots addIndex:slot];
+}
+
+- (void)removeNode:(LMKeyPathNode *)node
+{
+    for (NSString *dependentKeyPath in [node dependentKeyPaths]) {
+        [self unobserve:[node target] keyPath:dependentKeyPath node:node];
+    }
+
+    [_owner removeObserver:self forKeyPath:[node key] context:(__bridge void *)node];
+
+    [_nodes removeObjectForKey:[node key]];
+}
+
+- (void)removeAllBindings
+{
+    for (LMKeyPathNode *node in [_nodes allValues]) {
+        [self removeNode:node];
+    }
+
+    for (NSUInteger slot = 0; slot < _count; slot++) {
+        [self cancelFormatOperationAtSlot:slot];
+    }
+
+    _count = 0;
+
+    [_views setCount:0];
+    [_values setCount:0];
+    [_formatOperations setCount:0];
+
+    [_freeSlots removeAllIndexes];
+
+    [pendingHubs removeObjectForKey:_owner];
+}
+
+- (void)rebindKey:(NSString *)key toSource:(id)source
+{
+    LMKeyPathNode *node = [_nodes objectForKey:key];
+
+    // The change notification for the key is ignored, since the node's bindings are updated below
+    _rebindingNode = node;
+
+    [_owner setValue:source forKey:key];
+
+    _rebindingNode = nil;
+
+    if (node != nil) {
+        [self retarget:node target:source];
+
+        [self updateSlots:[[node slots] copy]];
+    }
+}
+
+- (void)retarget:(LMKeyPathNode *)node target:(id)target
+{
+    if (target != [node target]) {
+        for (NSString *dependentKeyPath in [node dependentKeyPaths]) {
+            [self unobserve:[node target] keyPath:dependentKeyPath node:node];
+            [self observe:target keyPath:dependentKeyPath node:node];
+        }
+
+        [node setTarget:target];
+    }
+}
+
+- (void)observe:(id)target keyPath:(NSString *)keyPath node:(LMKeyPathNode *)node
+{
+    if (target != nil && !LMIsCollection(target)) {
+        [target addObserver:self forKeyPath:keyPath options:0 context:(__bridge void *)node];
+    }
+}
+
+- (void)unobserve:(id)target keyPath:(NSString *)keyPath node:(LMKeyPathNode *)node
+{
+    if (target != nil && !LMIsCollection(target)) {
+        [target removeObserver:self forKeyPath:keyPath context:(__bridge void *)node];
+    }
+}
+
+- (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary *)change context:(void *)context
+{
+    LMKeyPathNode *node = (__bridge LMKeyPathNode *)context;
+
+    NSIndexSet *slots;
+    if (object == _owner) {
+        if (node == _rebindingNode) {
+            return;
+        }
+
+        [self retarget:node target:[_owner valueForKeyPath:[node key]]];
+
+        slots = [[node slots] copy];
+    } else {
+        slots = [[[node dependentKeyPaths] objectForKey:keyPath] copy];
+    }
+
+    [self updateSlots:slots];
+}
+
+- (void)updateSlots:(NSIndexSet *)slots
+{
+    NSMutableIndexSet *deadSlots = nil;
+
+    for (NSUInteger slot = [slots firstIndex]; slot != NSNotFound; slot = [slots indexGreaterThanIndex:slot]) {
+        if (slot >= _count || !(_flags[slot] & LMBindingActive)) {
+            continue;
+        }
+
+        if ([_views pointerAtIndex:slot] == NULL) {
+            if (deadSlots == nil) {
+                deadSlots = [NSMutableIndexSet new];
+            }
+
+            [deadSlots addIndex:slot];
+        } else {
+            [self setNeedsUpdate:slot];
+        }
+    }
+
+    // Bindings whose views have been deallocated are removed along with any observers that only they required
+    for (NSUInteger slot = [deadSlots firstIndex]; slot != NSNotFound; slot = [deadSlots indexGreaterThanIndex:slot]) {
+        [self removeBindingAtSlot:slot];
+    }
+}
+
+- (void)setNeedsUpdate:(NSUInteger)slot
+{
+    if (!_coalescesUpdates) {
+        [self updateBindingAtSlot:slot];
+    } else if (_flags[slot] & LMBindingPending) {
+        coalescedUpdateCount++;
+    } else {
+        _flags[slot] |= LMBindingPending;
+
+        [LMBindingHub schedule:self];
+    }
+}
+
+- (void)updatePendingBindings
+{
+    for (NSUInteger slot = 0; slot < _count; slot++) {
+        if (_flags[slot] & LMBindingPending) {
+            _flags[slot] &= ~LMBindingPending;
+
+            [self updateBindingAtSlot:slot];
+        }
+    }
+}
+
+- (void)resumeSuspendedBindingsForView:(UIView *)view
+{
+    for (NSUInteger slot = 0; slot < _count; slot++) {
+        if ((_flags[slot] & LMBindingSuspended) && [_views pointerAtIndex:slot] == (__bridge void *)view) {
+            _flags[slot] &= ~LMBindingSuspended;
+
+            [self setNeedsUpdate:slot];
+        }
+    }
+}
+
+- (void)updateBindingAtSlot:(NSUInteger)slot
+{
+    UIView *view = (__bridge UIView *)[_views pointerAtIndex:slot];
+
+    if (view == nil) {
+        return;
+    }
+
+    if (_suspendsOffscreenBindings && !LMIsVisible(view)) {
+        // The binding is updated once its view becomes visible again
+        if (!(_flags[slot] & LMBindingSuspended)) {
+            _flags[slot] |= LMBindingSuspended;
+
+            [LMBindingHub suspendView:view hub:self];
+        }
+
+        suspendedUpdateCount++;
+
+        return;
+    }
+
+    updateCount++;
+
+    // Any formatting that is still in progress has been superseded
+    [self cancelFormatOperationAtSlot:slot];
+
+    LMCompiledBinding *compiledBinding = LMCompiledBindingAtIndex(_compiledBindingIndices[slot]);
+
+    id value = [[compiledBinding expression] evaluateWithObject:_owner];
+
+    if (value != nil && value != [NSNull null]) {
+        if (_formatterIndices[slot] != LMNoFormatter) {
+            NSFormatter *formatter = [self formatterAtIndex:_formatterIndices[slot]];
+
+            if (formatter != nil) {
+                // Initial values are formatted synchronously so that they are in place when the view has
+                // loaded, and values that cannot be copied are only read on the main thread
+                if (_formatsAsynchronously && deferralDepth == 0 && [value conformsToProtocol:@protocol(NSCopying)]) {
+                    NSFormatter *queueFormatter = [self queueFormatterAtIndex:_formatterIndices[slot]];
+
+                    if (queueFormatter != nil) {
+                        [self formatValue:value withFormatter:queueFormatter slot:slot];
+
+                        return;
+                    }
+                }
+
+                value = [formatter stringForObjectValue:value];
+            }
+        }
+
+        [self writeValue:value slot:slot];
+    }
+}
+
+- (void)writeValue:(id)value slot:(NSUInteger)slot
+{
+    UIView *view = (__bridge UIView *)[_views pointerAtIndex:slot];
+
+    if (view == nil) {
+        return;
+    }
+
+    // Writes are skipped when the value matches the value most recently written by this binding
+    id previousValue = (__bridge id)[_values pointerAtIndex:slot];
+
+    if (previousValue != nil && [value isEqual:previousValue]) {
+        unchangedValueCount++;
+
+        return;
+    }
+
+    [view setValue:value forKeyPath:LMTargetKeyPathAtIndex(_keyPathIndices[slot])];
+
+    if (slot < _count) {
+        id writtenValue = ((_flags[slot] & LMBindingWritesUnchangedValues) || !LMIsImmutableValue(value)) ? nil : [value copy];
+
+        [_values replacePointerAtIndex:slot withPointer:(__bridge void *)writtenValue];
+    }
+}
+
+- (void)formatValue:(id)value withFormatter:(NSFormatter *)formatter slot:(NSUInteger)slot
+{
+    value = [value copy];
+
+    // Results are cached by formatter and value; default formatters are identified by their specifiers
+    id formatterKey = _providesFormatters ? formatter : [LMFormatterSpecifierAtIndex(_formatterIndices[slot]) key];
+
+    LMFormattedValueKey *key = [[LMFormattedValueKey alloc] initWithGeneration:_formatterGeneration formatterKey:formatterKey value:value];
+
+    NSString *string = [formattedValues objectForKey:key];
+
+    if (string != nil) {
+        [self writeValue:string slot:slot];
+
+        return;
+    }
+
+    NSBlockOperation *operation = [NSBlockOperation new];
+
+    __weak LMBindingHub *weakSelf = self;
+    __weak NSBlockOperation *weakOperation = operation;
+
+    [operation addExecutionBlock:^{
+        NSBlockOperation *strongOperation = weakOperation;
+
+        if (strongOperation == nil || [strongOperation isCancelled]) {
+            return;
+        }
+
+        NSString *string = [formatter stringForObjectValue:value];
+
+        if (string != nil) {
+            [formattedValues setObject:string forKey:key];
+        }
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf didFormatValue:string operation:strongOperation slot:slot];
+        });
+    }];
+
+    [_formatOperations replacePointerAtIndex:slot withPointer:(__bridge void *)operation];
+
+    [formatQueue addOperation:operation];
+}
+
+- (void)didFormatValue:(NSString *)string operation:(NSOperation *)operation slot:(NSUInteger)slot
+{
+    // Results of operations that were cancelled or replaced by a newer request are discarded
+    if ([operation isCancelled] || slot >= _count || [_formatOperations pointerAtIndex:slot] != (__bridge void *)operation) {
+        return;
+    }
+
+    [_formatOperations replacePointerAtIndex:slot withPointer:NULL];
+
+    [self writeValue:string slot:slot];
+}
+
+- (void)cancelFormatOperationAtSlot:(NSUInteger)slot
+{
+    NSOperation *operation = (__bridge NSOperation *)[_formatOperations pointerAtIndex:slot];
+
+    if (operation != nil) {
+        [operation cancel];
+
+        [_formatOperations replacePointerAtIndex:slot withPointer:NULL];
+    }
+}
+
+- (NSFormatter *)formatterAtIndex:(uint32_t)index
+{
+    os_unfair_lock_lock(&formatterLock);
+
+    NSUInteger generation = formatterGeneration;
+
+    os_unfair_lock_unlock(&formatterLock);
+
+    if (_formatterGeneration != generation) {
+        [_formatters removeAllObjects];
+        [_queueFormatters removeAllObjects];
+
+        _formatterGeneration = generation;
+    }
+
+    NSNumber *key = @(index);
+
+    id formatter = [_formatters objectForKey:key];
+
+    if (formatter == nil) {
+        LMFormatterSpecifier *formatterSpecifier = LMFormatterSpecifierAtIndex(index);
+
+        if (_providesFormatters) {
+            formatter = [_owner formatterWithName:[formatterSpecifier name] arguments:[formatterSpecifier arguments]];
+        } else {
+            os_unfair_lock_lock(&formatterLock);
+
+            formatter = [sharedFormatters objectForKey:[formatterSpecifier key]];
+
+            os_unfair_lock_unlock(&formatterLock);
+
+            if (formatter == nil) {
+                formatter = [_owner formatterWithName:[formatterSpecifier name] arguments:[formatterSpecifier arguments]];
+
+                os_unfair_lock_lock(&formatterLock);
+
+                if (formatterGeneration == generation) {
+                    [sharedFormatters setObject:(formatter == nil) ? [NSNull null] : formatter forKey:[formatterSpecifier key]];
+                }
+
+                os_unfair_lock_unlock(&formatterLock);
+            }
+        }
+
+        if (formatter == nil) {
+            formatter = [NSNull null];
+        }
+
+        [_formatters setObject:formatter forKey:key];
+    }
+
+    return (formatter == [NSNull null]) ? nil : formatter;
+}
+
+- (NSFormatter *)queueFormatterAtIndex:(uint32_t)index
+{
+    // Formatters used by the format queue are kept apart from those used on the main thread, since not all
+    // formatters are thread-safe; the queue is serial, so a single instance per specifier can be shared
+    // by all owners that do not provide their own formatters
+    NSNumber *key = @(index);
+
+    id formatter = [_queueFormatters objectForKey:key];
+
+    if (formatter == nil) {
+        LMFormatterSpecifier *formatterSpecifier = LMFormatterSpecifierAtIndex(index);
+
+        if (_providesFormatters) {
+            formatter = [_owner formatterWithName:[formatterSpecifier name] arguments:[formatterSpecifier arguments]];
+        } else {
+            os_unfair_lock_lock(&formatterLock);
+
+            NSUInteger generation = formatterGeneration;
+
+            formatter = [sharedQueueFormatters objectForKey:[formatterSpecifier key]];
+
+            os_unfair_lock_unlock(&formatterLock);
+
+            if (formatter == nil) {
+                formatter = [_owner formatterWithName:[formatterSpecifier name] arguments:[formatterSpecifier arguments]];
+
+                os_unfair_lock_lock(&formatterLock);
+
+                if (formatterGeneration == generation) {
+                    [sharedQueueFormatters setObject:(formatter == nil) ? [NSNull null] : formatter forKey:[formatterSpecifier key]];
+                }
+
+                os_unfair_lock_unlock(&formatterLock);
+            }
+        }
+
+        if (formatter == nil) {
+            formatter = [NSNull null];
+        }
+
+        [_queueFormatters setObject:formatter forKey:key];
+    }
+
+    return (formatter == [NSNull null]) ? nil : formatter;
+}
+
+@end
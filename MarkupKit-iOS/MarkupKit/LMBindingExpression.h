@@ -0,0 +1,65 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Binding expression. Expressions consisting of key paths, numeric and string literals,
+ * arithmetic and comparison operators, the "sum", "count", "min", "max", and "average"
+ * functions, and <code>FUNCTION()</code> calls are compiled to a compact instruction
+ * sequence and evaluated directly using key-value coding. All other expressions are
+ * evaluated using <code>NSExpression</code>.
+ *
+ * This class depends only on Foundation.
+ */
+@interface LMBindingExpression : NSObject
+
+/**
+ * Creates a binding expression.
+ *
+ * @param string The expression string.
+ *
+ * @return The new expression.
+ */
+- (instancetype)initWithString:(NSString *)string;
+
+/**
+ * The expression string.
+ */
+@property (nonatomic, readonly) NSString *string;
+
+/**
+ * Indicates that the expression was compiled, rather than parsed by <code>NSExpression</code>.
+ */
+@property (nonatomic, readonly, getter=isCompiled) BOOL compiled;
+
+/**
+ * The distinct key paths referenced by the expression, in order of appearance.
+ */
+@property (nonatomic, readonly) NSArray<NSString *> *keyPaths;
+
+/**
+ * Evaluates the expression.
+ *
+ * @param object The object against which key paths will be evaluated.
+ *
+ * @return The result of the expression.
+ */
+- (nullable id)evaluateWithObject:(id)object;
+
+@end
+
+NS_ASSUME_NONNULL_END
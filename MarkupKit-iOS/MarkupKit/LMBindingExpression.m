@@ -0,0 +1,979 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#import "LMBindingExpression.h"
+
+#import <objc/message.h>
+#import <objc/runtime.h>
+
+typedef enum : uint8_t {
+    LMOpConstant = 0,
+    LMOpKeyPath,
+    LMOpSelf,
+    LMOpNegate,
+    LMOpAdd,
+    LMOpSubtract,
+    LMOpMultiply,
+    LMOpDivide,
+    LMOpPower,
+    LMOpEqual,
+    LMOpNotEqual,
+    LMOpLess,
+    LMOpLessOrEqual,
+    LMOpGreater,
+    LMOpGreaterOrEqual,
+    LMOpSum,
+    LMOpCount,
+    LMOpMinimum,
+    LMOpMaximum,
+    LMOpAverage,
+    LMOpCall
+} LMOpcode;
+
+typedef struct {
+    LMOpcode opcode;
+    uint8_t count;
+    uint16_t operand;
+} LMInstruction;
+
+#define LMBindingExpressionStackSize 32
+#define LMBindingExpressionMaximumArgumentCount 3
+
+@interface LMBindingCompiler : NSObject
+
+@property (nonatomic, readonly) NSData *instructions;
+@property (nonatomic, readonly) NSArray *constants;
+@property (nonatomic, readonly) NSArray<NSString *> *keyPaths;
+
+- (BOOL)compile:(NSString *)string;
+
+@end
+
+static BOOL LMIsIntegerNumber(NSNumber *number)
+{
+    const char *type = [number objCType];
+
+    return strcmp(type, @encode(float)) != 0 && strcmp(type, @encode(double)) != 0;
+}
+
+static id LMArithmeticValue(LMOpcode opcode, id left, id right)
+{
+    if (![left isKindOfClass:[NSNumber self]] || ![right isKindOfClass:[NSNumber self]]) {
+        return nil;
+    }
+
+    // Integer operands produce integer results, except for division and exponentiation; results that
+    // overflow are computed in floating point
+    if (opcode != LMOpDivide && opcode != LMOpPower && LMIsIntegerNumber(left) && LMIsIntegerNumber(right)) {
+        long long a = [left longLongValue], b = [right longLongValue], result;
+
+        BOOL overflow;
+        switch (opcode) {
+            case LMOpAdd: {
+                overflow = __builtin_saddll_overflow(a, b, &result);
+
+                break;
+            }
+
+            case LMOpSubtract: {
+                overflow = __builtin_ssubll_overflow(a, b, &result);
+
+                break;
+            }
+
+            default: {
+                overflow = __builtin_smulll_overflow(a, b, &result);
+
+                break;
+            }
+        }
+
+        if (!overflow) {
+            return [NSNumber numberWithLongLong:result];
+        }
+    }
+
+    double a = [left doubleValue], b = [right doubleValue];
+
+    switch (opcode) {
+        case LMOpAdd: {
+            return [NSNumber numberWithDouble:a + b];
+        }
+
+        case LMOpSubtract: {
+            return [NSNumber numberWithDouble:a - b];
+        }
+
+        case LMOpMultiply: {
+            return [NSNumber numberWithDouble:a * b];
+        }
+
+        case LMOpDivide: {
+            return [NSNumber numberWithDouble:a / b];
+        }
+
+        default: {
+            return [NSNumber numberWithDouble:pow(a, b)];
+        }
+    }
+}
+
+static id LMComparisonValue(LMOpcode opcode, id left, id right)
+{
+    if (opcode == LMOpEqual || opcode == LMOpNotEqual) {
+        BOOL equal = (left == right) || [left isEqual:right];
+
+        return [NSNumber numberWithBool:(opcode == LMOpEqual) ? equal : !equal];
+    }
+
+    // Only numbers, strings, and dates can be ordered, and only against values of the same kind; the
+    // public classes are checked because the concrete classes of their instances vary
+    if (!(([left isKindOfClass:[NSNumber self]] && [right isKindOfClass:[NSNumber self]])
+        || ([left isKindOfClass:[NSString self]] && [right isKindOfClass:[NSString self]])
+        || ([left isKindOfClass:[NSDate self]] && [right isKindOfClass:[NSDate self]]))) {
+        return nil;
+    }
+
+    NSComparisonResult result = [left compare:right];
+
+    switch (opcode) {
+        case LMOpLess: {
+            return [NSNumber numberWithBool:result == NSOrderedAscending];
+        }
+
+        case LMOpLessOrEqual: {
+            return [NSNumber numberWithBool:result != NSOrderedDescending];
+        }
+
+        case LMOpGreater: {
+            return [NSNumber numberWithBool:result == NSOrderedDescending];
+        }
+
+        default: {
+            return [NSNumber numberWithBool:result != NSOrderedAscending];
+        }
+    }
+}
+
+static id LMAggregateValue(LMOpcode opcode, __strong id *arguments, NSUInteger count)
+{
+    // A single collection argument is aggregated over its elements
+    id<NSFastEnumeration> values;
+    if (count == 1 && ([arguments[0] isKindOfClass:[NSArray self]] || [arguments[0] isKindOfClass:[NSSet self]]
+        || [arguments[0] isKindOfClass:[NSOrderedSet self]])) {
+        values = arguments[0];
+    } else {
+        NSMutableArray *array = [[NSMutableArray alloc] initWithCapacity:count];
+
+        for (NSUInteger i = 0; i < count; i++) {
+            if (arguments[i] != nil) {
+                [array addObject:arguments[i]];
+            }
+        }
+
+        values = array;
+    }
+
+    NSUInteger n = 0;
+
+    double sum = 0;
+
+    NSNumber *extreme = nil;
+
+    for (id value in values) {
+        if (opcode == LMOpCount) {
+            n++;
+
+            continue;
+        }
+
+        if (![value isKindOfClass:[NSNumber self]]) {
+            return nil;
+        }
+
+        n++;
+
+        sum += [value doubleValue];
+
+        if (extreme == nil
+            || (opcode == LMOpMinimum && [value compare:extreme] == NSOrderedAscending)
+            || (opcode == LMOpMaximum && [value compare:extreme] == NSOrderedDescending)) {
+            extreme = value;
+        }
+    }
+
+    switch (opcode) {
+        case LMOpSum: {
+            return [NSNumber numberWithDouble:sum];
+        }
+
+        case LMOpCount: {
+            return [NSNumber numberWithUnsignedInteger:n];
+        }
+
+        case LMOpAverage: {
+            return [NSNumber numberWithDouble:(n == 0) ? 0 : sum / n];
+        }
+
+        default: {
+            return extreme;
+        }
+    }
+}
+
+static id LMCallValue(id target, SEL selector, __strong id *arguments, NSUInteger count)
+{
+    Method method = class_getInstanceMethod(object_getClass(target), selector);
+
+    if (method == NULL || method_getNumberOfArguments(method) != count + 2) {
+        return nil;
+    }
+
+    // Only methods that accept and return objects can be called through an object-typed message send
+    char type[8];
+    method_getReturnType(method, type, sizeof(type));
+
+    if (type[0] != '@') {
+        return nil;
+    }
+
+    for (unsigned int i = 0; i < count; i++) {
+        method_getArgumentType(method, i + 2, type, sizeof(type));
+
+        if (type[0] != '@') {
+            return nil;
+        }
+    }
+
+    switch (count) {
+        case 0: {
+            return ((id (*)(id, SEL))objc_msgSend)(target, selector);
+        }
+
+        case 1: {
+            return ((id (*)(id, SEL, id))objc_msgSend)(target, selector, arguments[0]);
+        }
+
+        case 2: {
+            return ((id (*)(id, SEL, id, id))objc_msgSend)(target, selector, arguments[0], arguments[1]);
+        }
+
+        default: {
+            return ((id (*)(id, SEL, id, id, id))objc_msgSend)(target, selector, arguments[0], arguments[1], arguments[2]);
+        }
+    }
+}
+
+@implementation LMBindingExpression
+{
+    NSExpression *_expression;
+
+    LMInstruction *_instructions;
+    NSUInteger _count;
+
+    NSArray *_constants;
+}
+
+- (instancetype)initWithString:(NSString *)string
+{
+    self = [super init];
+
+    if (self) {
+        _string = string;
+
+        LMBindingCompiler *compiler = [LMBindingCompiler new];
+
+        if ([compiler compile:string]) {
+            NSData *instructions = [compiler instructions];
+
+            _count = [instructions length] / sizeof(LMInstruction);
+
+            _instructions = malloc([instructions length]);
+
+            memcpy(_instructions, [instructions bytes], [instructions length]);
+
+            _constants = [compiler constants];
+
+            _keyPaths = [compiler keyPaths];
+
+            _compiled = YES;
+        } else {
+            _expression = [NSExpression expressionWithFormat:string];
+
+            NSMutableOrderedSet *keyPaths = [NSMutableOrderedSet new];
+
+            [LMBindingExpression appendKeyPaths:keyPaths expression:_expression];
+
+            _keyPaths = [keyPaths array];
+        }
+    }
+
+    return self;
+}
+
++ (void)appendKeyPaths:(NSMutableOrderedSet *)keyPaths expression:(NSExpression *)expression
+{
+    switch ([expression expressionType]) {
+    case NSKeyPathExpressionType:
+        [keyPaths addObject:[expression keyPath]];
+
+        break;
+
+    case NSFunctionExpressionType:
+        for (NSExpression *argument in [expression arguments]) {
+            [self appendKeyPaths:keyPaths expression:argument];
+        }
+
+        break;
+
+    default:
+        break;
+    }
+}
+
+- (void)dealloc
+{
+    free(_instructions);
+}
+
+- (id)evaluateWithObject:(id)object
+{
+    if (_expression != nil) {
+        return [_expression expressionValueWithObject:object context:nil];
+    }
+
+    __strong id stack[LMBindingExpressionStackSize];
+
+    NSUInteger top = 0;
+
+    for (NSUInteger i = 0; i < _count; i++) {
+        LMInstruction instruction = _instructions[i];
+
+        switch (instruction.opcode) {
+            case LMOpConstant: {
+                stack[top++] = [_constants objectAtIndex:instruction.operand];
+
+                break;
+            }
+
+            case LMOpKeyPath: {
+                stack[top++] = [object valueForKeyPath:[_constants objectAtIndex:instruction.operand]];
+
+                break;
+            }
+
+            case LMOpSelf: {
+                stack[top++] = object;
+
+                break;
+            }
+
+            case LMOpNegate: {
+                id value = stack[top - 1];
+
+                if (![value isKindOfClass:[NSNumber self]]) {
+                    stack[top - 1] = nil;
+                } else if (LMIsIntegerNumber(value) && [value longLongValue] != LLONG_MIN) {
+                    stack[top - 1] = [NSNumber numberWithLongLong:-[value longLongValue]];
+                } else {
+                    stack[top - 1] = [NSNumber numberWithDouble:-[value doubleValue]];
+                }
+
+                break;
+            }
+
+            case LMOpAdd:
+            case LMOpSubtract:
+            case LMOpMultiply:
+            case LMOpDivide:
+            case LMOpPower: {
+                top--;
+
+                stack[top - 1] = LMArithmeticValue(instruction.opcode, stack[top - 1], stack[top]);
+
+                stack[top] = nil;
+
+                break;
+            }
+
+            case LMOpEqual:
+            case LMOpNotEqual:
+            case LMOpLess:
+            case LMOpLessOrEqual:
+            case LMOpGreater:
+            case LMOpGreaterOrEqual: {
+                top--;
+
+                stack[top - 1] = LMComparisonValue(instruction.opcode, stack[top - 1], stack[top]);
+
+                stack[top] = nil;
+
+                break;
+            }
+
+            case LMOpSum:
+            case LMOpCount:
+            case LMOpMinimum:
+            case LMOpMaximum:
+            case LMOpAverage: {
+                top -= instruction.count;
+
+                id value = LMAggregateValue(instruction.opcode, &stack[top], instruction.count);
+
+                for (NSUInteger j = 0; j < instruction.count; j++) {
+                    stack[top + j] = nil;
+                }
+
+                stack[top++] = value;
+
+                break;
+            }
+
+            case LMOpCall: {
+                top -= instruction.count + 1;
+
+                id value = LMCallValue(stack[top], NSSelectorFromString([_constants objectAtIndex:instruction.operand]),
+                    &stack[top + 1], instruction.count);
+
+                for (NSUInteger j = 0; j <= instruction.count; j++) {
+                    stack[top + j] = nil;
+                }
+
+                stack[top++] = value;
+
+                break;
+            }
+        }
+    }
+
+    return stack[0];
+}
+
+- (NSString *)description
+{
+    return _string;
+}
+
+@end
+
+@implementation LMBindingCompiler
+{
+    unichar *_characters;
+    NSUInteger _length;
+    NSUInteger _position;
+
+    NSMutableData *_instructions;
+    NSMutableArray *_constants;
+    NSMutableOrderedSet<NSString *> *_keyPaths;
+
+    NSUInteger _depth;
+}
+
+static NSSet *reservedWords;
+
++ (void)initialize
+{
+    // Reserved words of the NSExpression format syntax; expressions that use any of these
+    // other than the ones supported below are left to NSExpression
+    reservedWords = [NSSet setWithArray:@[
+        @"and", @"or", @"in", @"not", @"all", @"any", @"some", @"none", @"like", @"matches",
+        @"contains", @"beginswith", @"endswith", @"between", @"null", @"nil", @"self", @"true",
+        @"false", @"yes", @"no", @"first", @"last", @"size", @"anykey", @"subquery", @"fetch",
+        @"cast", @"ternary", @"function", @"uti-conforms-to", @"uti-equals"
+    ]];
+}
+
+- (BOOL)compile:(NSString *)string
+{
+    _length = [string length];
+
+    _characters = malloc(MAX(_length, 1) * sizeof(unichar));
+
+    [string getCharacters:_characters range:NSMakeRange(0, _length)];
+
+    _position = 0;
+
+    _instructions = [NSMutableData new];
+    _constants = [NSMutableArray new];
+    _keyPaths = [NSMutableOrderedSet new];
+
+    _depth = 0;
+
+    BOOL result = [self compileComparison];
+
+    if (result) {
+        [self skipWhitespace];
+
+        result = (_position == _length && _depth == 1);
+    }
+
+    free(_characters);
+
+    _characters = NULL;
+
+    return result;
+}
+
+- (NSData *)instructions
+{
+    return _instructions;
+}
+
+- (NSArray *)constants
+{
+    return _constants;
+}
+
+- (NSArray<NSString *> *)keyPaths
+{
+    return [_keyPaths array];
+}
+
+- (void)skipWhitespace
+{
+    while (_position < _length && [[NSCharacterSet whitespaceAndNewlineCharacterSet] characterIsMember:_characters[_position]]) {
+        _position++;
+    }
+}
+
+- (unichar)peek
+{
+    [self skipWhitespace];
+
+    return (_position < _length) ? _characters[_position] : 0;
+}
+
+- (unichar)peekAtOffset:(NSUInteger)offset
+{
+    return (_position + offset < _length) ? _characters[_position + offset] : 0;
+}
+
+- (BOOL)emit:(LMOpcode)opcode count:(NSUInteger)count operand:(NSUInteger)operand pushes:(NSInteger)pushes
+{
+    if (operand > UINT16_MAX || (NSInteger)_depth + pushes < 0 || (NSInteger)_depth + pushes > LMBindingExpressionStackSize) {
+        return NO;
+    }
+
+    _depth += pushes;
+
+    LMInstruction instruction = {opcode, (uint8_t)count, (uint16_t)operand};
+
+    [_instructions appendBytes:&instruction length:sizeof(LMInstruction)];
+
+    return YES;
+}
+
+- (BOOL)emitConstant:(id)constant
+{
+    [_constants addObject:constant];
+
+    return [self emit:LMOpConstant count:0 operand:[_constants count] - 1 pushes:1];
+}
+
+- (BOOL)compileComparison
+{
+    if (![self compileAdditive]) {
+        return NO;
+    }
+
+    unichar c = [self peek];
+    unichar next = [self peekAtOffset:1];
+
+    LMOpcode opcode;
+    NSUInteger length = 2;
+    if (c == '=' && next == '=') {
+        opcode = LMOpEqual;
+    } else if (c == '!' && next == '=') {
+        opcode = LMOpNotEqual;
+    } else if (c == '<' && next == '=') {
+        opcode = LMOpLessOrEqual;
+    } else if (c == '>' && next == '=') {
+        opcode = LMOpGreaterOrEqual;
+    } else if (c == '<' && next != '>') {
+        opcode = LMOpLess;
+        length = 1;
+    } else if (c == '>') {
+        opcode = LMOpGreater;
+        length = 1;
+    } else {
+        return YES;
+    }
+
+    _position += length;
+
+    return [self compileAdditive] && [self emit:opcode count:0 operand:0 pushes:-1];
+}
+
+- (BOOL)compileAdditive
+{
+    if (![self compileMultiplicative]) {
+        return NO;
+    }
+
+    for (;;) {
+        unichar c = [self peek];
+
+        if (c != '+' && c != '-') {
+            return YES;
+        }
+
+        _position++;
+
+        if (![self compileMultiplicative] || ![self emit:(c == '+') ? LMOpAdd : LMOpSubtract count:0 operand:0 pushes:-1]) {
+            return NO;
+        }
+    }
+}
+
+- (BOOL)compileMultiplicative
+{
+    if (![self compilePower]) {
+        return NO;
+    }
+
+    for (;;) {
+        unichar c = [self peek];
+
+        if ((c != '*' && c != '/') || (c == '*' && [self peekAtOffset:1] == '*')) {
+            return YES;
+        }
+
+        _position++;
+
+        if (![self compilePower] || ![self emit:(c == '*') ? LMOpMultiply : LMOpDivide count:0 operand:0 pushes:-1]) {
+            return NO;
+        }
+    }
+}
+
+- (BOOL)compilePower
+{
+    if (![self compileUnary]) {
+        return NO;
+    }
+
+    if ([self peek] != '*' || [self peekAtOffset:1] != '*') {
+        return YES;
+    }
+
+    _position += 2;
+
+    // Exponentiation is right-associative
+    return [self compilePower] && [self emit:LMOpPower count:0 operand:0 pushes:-1];
+}
+
+- (BOOL)compileUnary
+{
+    if ([self peek] == '-') {
+        _position++;
+
+        return [self compileUnary] && [self emit:LMOpNegate count:0 operand:0 pushes:0];
+    }
+
+    return [self compilePrimary];
+}
+
+- (BOOL)compilePrimary
+{
+    unichar c = [self peek];
+
+    if (c == '(') {
+        _position++;
+
+        if (![self compileComparison] || [self peek] != ')') {
+            return NO;
+        }
+
+        _position++;
+
+        return YES;
+    } else if ((c >= '0' && c <= '9') || c == '.') {
+        return [self compileNumber];
+    } else if (c == '\'' || c == '"') {
+        NSString *string = [self readString];
+
+        return (string != nil) && [self emitConstant:string];
+    } else if ([self isKeyPathCharacter:c]) {
+        return [self compileIdentifier];
+    } else {
+        return NO;
+    }
+}
+
+- (BOOL)compileNumber
+{
+    NSUInteger start = _position;
+
+    BOOL integer = YES;
+
+    while (_position < _length && _characters[_position] >= '0' && _characters[_position] <= '9') {
+        _position++;
+    }
+
+    if (_position < _length && _characters[_position] == '.') {
+        integer = NO;
+
+        _position++;
+
+        while (_position < _length && _characters[_position] >= '0' && _characters[_position] <= '9') {
+            _position++;
+        }
+    }
+
+    if (_position < _length && (_characters[_position] == 'e' || _characters[_position] == 'E')) {
+        integer = NO;
+
+        _position++;
+
+        if (_position < _length && (_characters[_position] == '+' || _characters[_position] == '-')) {
+            _position++;
+        }
+
+        while (_position < _length && _characters[_position] >= '0' && _characters[_position] <= '9') {
+            _position++;
+        }
+    }
+
+    // Hexadecimal, octal, and binary literals, as well as malformed numbers, are left to NSExpression
+    if (_position < _length && [self isKeyPathCharacter:_characters[_position]]) {
+        return NO;
+    }
+
+    char buffer[64];
+
+    NSUInteger length = _position - start;
+
+    if (length == 0 || length >= sizeof(buffer) || (length == 1 && _characters[start] == '.')) {
+        return NO;
+    }
+
+    for (NSUInteger i = 0; i < length; i++) {
+        buffer[i] = (char)_characters[start + i];
+    }
+
+    buffer[length] = 0;
+
+    char *end;
+
+    NSNumber *number;
+    if (integer) {
+        errno = 0;
+
+        long long value = strtoll(buffer, &end, 10);
+
+        // Integers that are out of range are represented as floating-point values, as by NSExpression
+        if (errno == ERANGE) {
+            number = [NSNumber numberWithDouble:strtod(buffer, &end)];
+        } else {
+            number = [NSNumber numberWithLongLong:value];
+        }
+    } else {
+        number = [NSNumber numberWithDouble:strtod(buffer, &end)];
+    }
+
+    return (*end == 0) && [self emitConstant:number];
+}
+
+- (NSString *)readString
+{
+    unichar quote = _characters[_position++];
+
+    NSUInteger start = _position;
+
+    while (_position < _length && _characters[_position] != quote) {
+        // Escape sequences are left to NSExpression
+        if (_characters[_position] == '\\') {
+            return nil;
+        }
+
+        _position++;
+    }
+
+    if (_position == _length) {
+        return nil;
+    }
+
+    NSString *string = [NSString stringWithCharacters:&_characters[start] length:_position - start];
+
+    _position++;
+
+    return string;
+}
+
+- (BOOL)isKeyPathCharacter:(unichar)c
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '@';
+}
+
+- (BOOL)compileIdentifier
+{
+    NSUInteger start = _position;
+
+    for (;;) {
+        if (_position == _length || ![self isKeyPathCharacter:_characters[_position]]) {
+            return NO;
+        }
+
+        while (_position < _length && [self isKeyPathCharacter:_characters[_position]]) {
+            _position++;
+        }
+
+        if (_position < _length && _characters[_position] == '.') {
+            _position++;
+        } else {
+            break;
+        }
+    }
+
+    NSString *keyPath = [NSString stringWithCharacters:&_characters[start] length:_position - start];
+
+    if ([self peek] == ':') {
+        return [self compileAggregate:keyPath];
+    }
+
+    NSString *word = [keyPath lowercaseString];
+
+    if ([reservedWords containsObject:word]) {
+        if ([word isEqual:@"function"]) {
+            return [self compileCall];
+        } else if ([word isEqual:@"self"]) {
+            return [self emit:LMOpSelf count:0 operand:0 pushes:1];
+        } else if ([word isEqual:@"true"] || [word isEqual:@"yes"]) {
+            return [self emitConstant:@YES];
+        } else if ([word isEqual:@"false"] || [word isEqual:@"no"]) {
+            return [self emitConstant:@NO];
+        } else {
+            return NO;
+        }
+    }
+
+    NSUInteger index = [_constants indexOfObject:keyPath];
+
+    if (index == NSNotFound) {
+        [_constants addObject:keyPath];
+
+        index = [_constants count] - 1;
+    }
+
+    [_keyPaths addObject:keyPath];
+
+    return [self emit:LMOpKeyPath count:0 operand:index pushes:1];
+}
+
+- (BOOL)compileAggregate:(NSString *)name
+{
+    LMOpcode opcode;
+    if ([name isEqual:@"sum"]) {
+        opcode = LMOpSum;
+    } else if ([name isEqual:@"count"]) {
+        opcode = LMOpCount;
+    } else if ([name isEqual:@"min"]) {
+        opcode = LMOpMinimum;
+    } else if ([name isEqual:@"max"]) {
+        opcode = LMOpMaximum;
+    } else if ([name isEqual:@"average"]) {
+        opcode = LMOpAverage;
+    } else {
+        return NO;
+    }
+
+    _position++;
+
+    if ([self peek] != '(') {
+        return NO;
+    }
+
+    _position++;
+
+    NSUInteger count = 0;
+
+    if (![self compileArguments:&count] || count == 0 || count > UINT8_MAX) {
+        return NO;
+    }
+
+    return [self emit:opcode count:count operand:0 pushes:1 - (NSInteger)count];
+}
+
+- (BOOL)compileCall
+{
+    if ([self peek] != '(') {
+        return NO;
+    }
+
+    _position++;
+
+    // The target is followed by a quoted selector name and up to three arguments
+    if (![self compileComparison] || [self peek] != ',') {
+        return NO;
+    }
+
+    _position++;
+
+    unichar c = [self peek];
+
+    if (c != '\'' && c != '"') {
+        return NO;
+    }
+
+    NSString *selector = [self readString];
+
+    if (selector == nil) {
+        return NO;
+    }
+
+    NSUInteger count = 0;
+
+    if ([self peek] == ',') {
+        _position++;
+
+        if (![self compileArguments:&count]) {
+            return NO;
+        }
+    } else if ([self peek] == ')') {
+        _position++;
+    } else {
+        return NO;
+    }
+
+    if (count > LMBindingExpressionMaximumArgumentCount) {
+        return NO;
+    }
+
+    [_constants addObject:selector];
+
+    return [self emit:LMOpCall count:count operand:[_constants count] - 1 pushes:-(NSInteger)count];
+}
+
+- (BOOL)compileArguments:(NSUInteger *)count
+{
+    for (;;) {
+        if (![self compileComparison]) {
+            return NO;
+        }
+
+        (*count)++;
+
+        unichar c = [self peek];
+
+        _position++;
+
+        if (c == ')') {
+            return YES;
+        } else if (c != ',') {
+            return NO;
+        }
+    }
+}
+
+@end
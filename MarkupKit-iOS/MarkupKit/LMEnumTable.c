@@ -0,0 +1,122 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "LMEnumTable.h"
+
+#include <string.h>
+
+enum {
+    LMEnumTableUnbuilt = 0,
+    LMEnumTableBuilding = 1,
+    LMEnumTableReady = 2
+};
+
+#define LMEnumTableMaximumSeedCount 4096
+
+static uint32_t LMEnumTableHash(uint32_t seed, const char *bytes, size_t length)
+{
+    uint32_t hash = 2166136261u ^ seed;
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)bytes[i];
+        hash *= 16777619u;
+    }
+
+    return hash ^ (hash >> 15);
+}
+
+static bool LMEnumTableIsEqual(const char *name, const char *bytes, size_t length)
+{
+    return strlen(name) == length && memcmp(name, bytes, length) == 0;
+}
+
+static void LMEnumTableBuild(LMEnumTable *table)
+{
+    // Search for a seed that maps every name to a distinct slot; tables with no such
+    // seed are left with an empty mask and continue to be searched linearly
+    uint32_t slotCount = 1;
+
+    while (slotCount < table->count * 2) {
+        slotCount <<= 1;
+    }
+
+    for (; slotCount <= LMEnumTableSlotCount; slotCount <<= 1) {
+        for (uint32_t seed = 0; seed < LMEnumTableMaximumSeedCount; seed++) {
+            memset(table->slots, 0, sizeof(table->slots));
+
+            size_t i = 0;
+
+            for (; i < table->count; i++) {
+                const char *name = table->entries[i].name;
+
+                uint32_t slot = LMEnumTableHash(seed, name, strlen(name)) & (slotCount - 1);
+
+                if (table->slots[slot] != 0) {
+                    break;
+                }
+
+                table->slots[slot] = (uint8_t)(i + 1);
+            }
+
+            if (i == table->count) {
+                table->seed = seed;
+                table->mask = slotCount - 1;
+
+                return;
+            }
+        }
+    }
+
+    table->mask = 0;
+}
+
+bool LMEnumTableLookup(LMEnumTable *table, const char *bytes, size_t length, long *value)
+{
+    int state = __atomic_load_n(&table->state, __ATOMIC_ACQUIRE);
+
+    if (state == LMEnumTableUnbuilt) {
+        int expected = LMEnumTableUnbuilt;
+
+        if (__atomic_compare_exchange_n(&table->state, &expected, LMEnumTableBuilding, false,
+            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            LMEnumTableBuild(table);
+
+            __atomic_store_n(&table->state, LMEnumTableReady, __ATOMIC_RELEASE);
+
+            state = LMEnumTableReady;
+        }
+    }
+
+    if (state == LMEnumTableReady && table->mask != 0) {
+        uint8_t slot = table->slots[LMEnumTableHash(table->seed, bytes, length) & table->mask];
+
+        if (slot != 0 && LMEnumTableIsEqual(table->entries[slot - 1].name, bytes, length)) {
+            *value = table->entries[slot - 1].value;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    for (size_t i = 0; i < table->count; i++) {
+        if (LMEnumTableIsEqual(table->entries[i].name, bytes, length)) {
+            *value = table->entries[i].value;
+
+            return true;
+        }
+    }
+
+    return false;
+}
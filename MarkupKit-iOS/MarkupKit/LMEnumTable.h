@@ -0,0 +1,119 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef LMEnumTable_h
+#define LMEnumTable_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Enumeration table entry.
+ */
+typedef struct {
+    const char *name;
+    long value;
+} LMEnumEntry;
+
+/**
+ * Maximum number of hash slots in an enumeration table.
+ */
+#define LMEnumTableSlotCount 64
+
+/**
+ * Enumeration table. Tables map markup names to enumeration values, and are declared
+ * statically using <code>LMEnumTableMake()</code>. Because entry values are defined by the
+ * SDK, the table's perfect hash is not generated at build time; instead, a seed is searched
+ * for on first use and the resulting slots are stored in the table itself, so no heap
+ * storage is required. Lookups performed while another thread is computing the hash fall
+ * back to a linear search.
+ *
+ * The search tries at most 4096 seeds for each slot count up to
+ * <code>LMEnumTableSlotCount</code>. Tables with more than half that many entries, or for
+ * which no seed is found, are always searched linearly.
+ */
+typedef struct {
+    const LMEnumEntry *entries;
+    size_t count;
+    int state;
+    uint32_t seed;
+    uint32_t mask;
+    uint8_t slots[LMEnumTableSlotCount];
+} LMEnumTable;
+
+/**
+ * Creates a table initializer for a static array of entries.
+ */
+#define LMEnumTableMake(entries) { (entries), sizeof(entries) / sizeof((entries)[0]), 0, 0, 0, { 0 } }
+
+/**
+ * Looks up a value in an enumeration table.
+ *
+ * @param table The table.
+ * @param bytes The name's UTF-8 bytes.
+ * @param length The length of the name in bytes.
+ * @param value On return, the value associated with the name.
+ *
+ * @return <code>true</code> if the table contains the name; <code>false</code>, otherwise.
+ */
+bool LMEnumTableLookup(LMEnumTable *table, const char *bytes, size_t length, long *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __OBJC__
+
+#import <Foundation/Foundation.h>
+
+/**
+ * Returns the value associated with a markup name.
+ *
+ * @param table The table.
+ * @param name The name.
+ *
+ * @return The value, or <code>nil</code> if the name is not a string or is not defined by the table.
+ */
+static inline NSNumber *LMEnumValue(LMEnumTable *table, id name)
+{
+    if (![name isKindOfClass:[NSString class]]) {
+        return nil;
+    }
+
+    const char *bytes = CFStringGetCStringPtr((__bridge CFStringRef)name, kCFStringEncodingUTF8);
+
+    char buffer[64];
+
+    if (bytes == NULL) {
+        // Names longer than the buffer are not defined by any table
+        if (![name getCString:buffer maxLength:sizeof(buffer) encoding:NSUTF8StringEncoding]) {
+            return nil;
+        }
+
+        bytes = buffer;
+    }
+
+    long value;
+
+    return LMEnumTableLookup(table, bytes, strlen(bytes), &value) ? @(value) : nil;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,729 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "LMMarkupCompiler.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Template or property read from a properties instruction. Names and string values
+// refer to decoded text in the parser's buffer.
+typedef struct {
+    uint32_t type;
+
+    size_t name;
+    size_t nameLength;
+
+    size_t string;
+    size_t stringLength;
+
+    union {
+        double number;
+        int64_t integer;
+    };
+} LMMarkupEntry;
+
+typedef struct {
+    const char *position;
+    const char *end;
+
+    char *text;
+    size_t textLength;
+    size_t textCapacity;
+
+    LMMarkupEntry *entries;
+    uint32_t entryCount;
+    uint32_t entryCapacity;
+
+    bool failed;
+} LMMarkupJSON;
+
+// Entry type of a template; all other entries are properties
+static const uint32_t kTemplateEntry = UINT32_MAX;
+
+// Longest floating-point literal that is converted; longer ones are left for the builder
+static const size_t kMaximumNumberLength = 63;
+
+static bool LMMarkupJSONIsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool LMMarkupJSONIsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static void LMMarkupJSONSkipSpace(LMMarkupJSON *json)
+{
+    while (json->position < json->end && LMMarkupJSONIsSpace(*json->position)) {
+        json->position++;
+    }
+}
+
+static bool LMMarkupJSONConsume(LMMarkupJSON *json, char c)
+{
+    LMMarkupJSONSkipSpace(json);
+
+    if (json->position == json->end || *json->position != c) {
+        return false;
+    }
+
+    json->position++;
+
+    return true;
+}
+
+static bool LMMarkupJSONConsumeLiteral(LMMarkupJSON *json, const char *literal)
+{
+    size_t length = strlen(literal);
+
+    if ((size_t)(json->end - json->position) < length || memcmp(json->position, literal, length) != 0) {
+        return false;
+    }
+
+    json->position += length;
+
+    return true;
+}
+
+static bool LMMarkupJSONAppend(LMMarkupJSON *json, const char *bytes, size_t length)
+{
+    if (json->text == NULL || json->textCapacity - json->textLength < length) {
+        size_t capacity = (json->textCapacity < 256) ? 256 : json->textCapacity;
+
+        while (capacity - json->textLength < length) {
+            capacity *= 2;
+        }
+
+        char *text = realloc(json->text, capacity);
+
+        if (text == NULL) {
+            json->failed = true;
+
+            return false;
+        }
+
+        json->text = text;
+        json->textCapacity = capacity;
+    }
+
+    if (length > 0) {
+        memcpy(json->text + json->textLength, bytes, length);
+
+        json->textLength += length;
+    }
+
+    return true;
+}
+
+static LMMarkupEntry *LMMarkupJSONAddEntry(LMMarkupJSON *json, uint32_t type)
+{
+    if (json->entryCount == json->entryCapacity) {
+        uint32_t capacity = (json->entryCapacity < 16) ? 16 : json->entryCapacity * 2;
+
+        LMMarkupEntry *entries = (capacity > json->entryCapacity) ? realloc(json->entries, (size_t)capacity * sizeof(LMMarkupEntry)) : NULL;
+
+        if (entries == NULL) {
+            json->failed = true;
+
+            return NULL;
+        }
+
+        json->entries = entries;
+        json->entryCapacity = capacity;
+    }
+
+    LMMarkupEntry *entry = &json->entries[json->entryCount++];
+
+    memset(entry, 0, sizeof(LMMarkupEntry));
+
+    entry->type = type;
+
+    return entry;
+}
+
+static bool LMMarkupJSONReadHex(LMMarkupJSON *json, uint32_t *value)
+{
+    if (json->end - json->position < 4) {
+        return false;
+    }
+
+    uint32_t result = 0;
+
+    for (int i = 0; i < 4; i++) {
+        char c = *json->position++;
+
+        if (c >= '0' && c <= '9') {
+            result = (result << 4) | (uint32_t)(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            result = (result << 4) | (uint32_t)(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            result = (result << 4) | (uint32_t)(c - 'A' + 10);
+        } else {
+            return false;
+        }
+    }
+
+    *value = result;
+
+    return true;
+}
+
+static bool LMMarkupJSONReadEscape(LMMarkupJSON *json)
+{
+    if (json->position == json->end) {
+        return false;
+    }
+
+    char c = *json->position++;
+
+    switch (c) {
+        case '"':
+        case '\\':
+        case '/': {
+            return LMMarkupJSONAppend(json, &c, 1);
+        }
+
+        case 'b': {
+            return LMMarkupJSONAppend(json, "\b", 1);
+        }
+
+        case 'f': {
+            return LMMarkupJSONAppend(json, "\f", 1);
+        }
+
+        case 'n': {
+            return LMMarkupJSONAppend(json, "\n", 1);
+        }
+
+        case 'r': {
+            return LMMarkupJSONAppend(json, "\r", 1);
+        }
+
+        case 't': {
+            return LMMarkupJSONAppend(json, "\t", 1);
+        }
+
+        case 'u': {
+            break;
+        }
+
+        default: {
+            return false;
+        }
+    }
+
+    uint32_t codePoint;
+
+    if (!LMMarkupJSONReadHex(json, &codePoint)) {
+        return false;
+    }
+
+    if (codePoint >= 0xD800 && codePoint < 0xDC00) {
+        uint32_t low;
+
+        if (!LMMarkupJSONConsumeLiteral(json, "\\u") || !LMMarkupJSONReadHex(json, &low) || low < 0xDC00 || low >= 0xE000) {
+            return false;
+        }
+
+        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+    } else if (codePoint >= 0xDC00 && codePoint < 0xE000) {
+        return false;
+    }
+
+    // Strings are passed to the builder as C strings, so embedded nulls are left for it to report
+    if (codePoint == 0) {
+        return false;
+    }
+
+    char bytes[4];
+    size_t length;
+
+    if (codePoint < 0x80) {
+        bytes[0] = (char)codePoint;
+
+        length = 1;
+    } else if (codePoint < 0x800) {
+        bytes[0] = (char)(0xC0 | (codePoint >> 6));
+        bytes[1] = (char)(0x80 | (codePoint & 0x3F));
+
+        length = 2;
+    } else if (codePoint < 0x10000) {
+        bytes[0] = (char)(0xE0 | (codePoint >> 12));
+        bytes[1] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        bytes[2] = (char)(0x80 | (codePoint & 0x3F));
+
+        length = 3;
+    } else {
+        bytes[0] = (char)(0xF0 | (codePoint >> 18));
+        bytes[1] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+        bytes[2] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        bytes[3] = (char)(0x80 | (codePoint & 0x3F));
+
+        length = 4;
+    }
+
+    return LMMarkupJSONAppend(json, bytes, length);
+}
+
+static bool LMMarkupJSONReadString(LMMarkupJSON *json, size_t *offset, size_t *length)
+{
+    if (!LMMarkupJSONConsume(json, '"')) {
+        return false;
+    }
+
+    *offset = json->textLength;
+
+    while (json->position < json->end) {
+        // Copy unescaped runs in one step
+        const char *start = json->position;
+
+        while (json->position < json->end && *json->position != '"' && *json->position != '\\'
+            && (uint8_t)*json->position >= 0x20) {
+            json->position++;
+        }
+
+        if (!LMMarkupJSONAppend(json, start, json->position - start)) {
+            return false;
+        }
+
+        if (json->position == json->end) {
+            break;
+        }
+
+        char c = *json->position++;
+
+        if (c == '"') {
+            *length = json->textLength - *offset;
+
+            return true;
+        }
+
+        if (c != '\\' || !LMMarkupJSONReadEscape(json)) {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+static bool LMMarkupJSONReadNumber(LMMarkupJSON *json, LMMarkupEntry *entry)
+{
+    const char *start = json->position;
+    const char *p = start;
+
+    bool negative = (p < json->end && *p == '-');
+
+    if (negative) {
+        p++;
+    }
+
+    if (p == json->end || !LMMarkupJSONIsDigit(*p)) {
+        return false;
+    }
+
+    const char *digits = p;
+
+    if (*p == '0') {
+        p++;
+    } else {
+        while (p < json->end && LMMarkupJSONIsDigit(*p)) {
+            p++;
+        }
+    }
+
+    const char *digitsEnd = p;
+
+    bool integral = true;
+
+    if (p < json->end && *p == '.') {
+        p++;
+
+        if (p == json->end || !LMMarkupJSONIsDigit(*p)) {
+            return false;
+        }
+
+        while (p < json->end && LMMarkupJSONIsDigit(*p)) {
+            p++;
+        }
+
+        integral = false;
+    }
+
+    if (p < json->end && (*p == 'e' || *p == 'E')) {
+        p++;
+
+        if (p < json->end && (*p == '+' || *p == '-')) {
+            p++;
+        }
+
+        if (p == json->end || !LMMarkupJSONIsDigit(*p)) {
+            return false;
+        }
+
+        while (p < json->end && LMMarkupJSONIsDigit(*p)) {
+            p++;
+        }
+
+        integral = false;
+    }
+
+    json->position = p;
+
+    if (integral) {
+        // Accumulate negatively so that the most negative value is representable
+        int64_t value = 0;
+
+        for (const char *q = digits; q < digitsEnd; q++) {
+            if (__builtin_mul_overflow(value, 10, &value) || __builtin_sub_overflow(value, *q - '0', &value)) {
+                integral = false;
+
+                break;
+            }
+        }
+
+        if (integral && (!negative && value == INT64_MIN)) {
+            integral = false;
+        }
+
+        if (integral) {
+            entry->type = LMMarkupValueInteger;
+            entry->integer = negative ? value : -value;
+
+            return true;
+        }
+    }
+
+    size_t length = p - start;
+
+    if (length > kMaximumNumberLength) {
+        return false;
+    }
+
+    char buffer[kMaximumNumberLength + 1];
+
+    memcpy(buffer, start, length);
+
+    buffer[length] = 0;
+
+    entry->type = LMMarkupValueNumber;
+    entry->number = strtod(buffer, NULL);
+
+    return true;
+}
+
+static bool LMMarkupJSONReadValue(LMMarkupJSON *json, LMMarkupEntry *entry)
+{
+    LMMarkupJSONSkipSpace(json);
+
+    if (json->position == json->end) {
+        return false;
+    }
+
+    switch (*json->position) {
+        case '"': {
+            entry->type = LMMarkupValueString;
+
+            return LMMarkupJSONReadString(json, &entry->string, &entry->stringLength);
+        }
+
+        case 't': {
+            entry->type = LMMarkupValueBoolean;
+            entry->number = 1;
+
+            return LMMarkupJSONConsumeLiteral(json, "true");
+        }
+
+        case 'f': {
+            entry->type = LMMarkupValueBoolean;
+            entry->number = 0;
+
+            return LMMarkupJSONConsumeLiteral(json, "false");
+        }
+
+        case 'n': {
+            entry->type = LMMarkupValueNull;
+
+            return LMMarkupJSONConsumeLiteral(json, "null");
+        }
+
+        default: {
+            return LMMarkupJSONReadNumber(json, entry);
+        }
+    }
+}
+
+static bool LMMarkupJSONReadObject(LMMarkupJSON *json, uint32_t type)
+{
+    if (!LMMarkupJSONConsume(json, '{')) {
+        return false;
+    }
+
+    if (LMMarkupJSONConsume(json, '}')) {
+        return true;
+    }
+
+    do {
+        uint32_t index = json->entryCount;
+
+        if (LMMarkupJSONAddEntry(json, type) == NULL) {
+            return false;
+        }
+
+        size_t name, nameLength;
+
+        if (!LMMarkupJSONReadString(json, &name, &nameLength) || !LMMarkupJSONConsume(json, ':')) {
+            return false;
+        }
+
+        json->entries[index].name = name;
+        json->entries[index].nameLength = nameLength;
+
+        if (type == kTemplateEntry) {
+            // Templates contain properties
+            if (!LMMarkupJSONReadObject(json, LMMarkupValueNull)) {
+                return false;
+            }
+        } else {
+            LMMarkupEntry entry = json->entries[index];
+
+            if (!LMMarkupJSONReadValue(json, &entry)) {
+                return false;
+            }
+
+            json->entries[index] = entry;
+        }
+    } while (LMMarkupJSONConsume(json, ','));
+
+    return LMMarkupJSONConsume(json, '}');
+}
+
+static bool LMMarkupJSONHasDuplicates(LMMarkupJSON *json)
+{
+    // Compares the names of the entries at each level; templates are typically small
+    for (uint32_t i = 0; i < json->entryCount; i++) {
+        const LMMarkupEntry *entry = &json->entries[i];
+
+        for (uint32_t j = i + 1; j < json->entryCount; j++) {
+            const LMMarkupEntry *other = &json->entries[j];
+
+            if ((other->type == kTemplateEntry) != (entry->type == kTemplateEntry)) {
+                if (entry->type != kTemplateEntry) {
+                    break;
+                }
+
+                continue;
+            }
+
+            if (other->nameLength == entry->nameLength
+                && memcmp(json->text + other->name, json->text + entry->name, entry->nameLength) == 0) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+static bool LMMarkupJSONRead(LMMarkupJSON *json)
+{
+    if (!LMMarkupJSONReadObject(json, kTemplateEntry)) {
+        return false;
+    }
+
+    LMMarkupJSONSkipSpace(json);
+
+    return json->position == json->end && !LMMarkupJSONHasDuplicates(json);
+}
+
+static bool LMMarkupAppendTemplates(LMMarkupDocumentRef document, LMMarkupJSON *json, uint32_t line)
+{
+    if (!LMMarkupDocumentAppendProperties(document, line)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < json->entryCount; i++) {
+        const LMMarkupEntry *entry = &json->entries[i];
+
+        uint32_t name = LMMarkupDocumentAddString(document, json->text + entry->name, entry->nameLength);
+
+        if (name == LMMarkupNone) {
+            return false;
+        }
+
+        bool result;
+
+        switch (entry->type) {
+            case kTemplateEntry: {
+                result = LMMarkupDocumentAppendTemplate(document, name);
+
+                break;
+            }
+
+            case LMMarkupValueString: {
+                uint32_t string = LMMarkupDocumentAddString(document, json->text + entry->string, entry->stringLength);
+
+                result = (string != LMMarkupNone && LMMarkupDocumentAppendProperty(document, name, LMMarkupValueString, string, 0));
+
+                break;
+            }
+
+            case LMMarkupValueInteger: {
+                result = LMMarkupDocumentAppendIntegerProperty(document, name, entry->integer);
+
+                break;
+            }
+
+            default: {
+                result = LMMarkupDocumentAppendProperty(document, name, entry->type, LMMarkupNone, entry->number);
+
+                break;
+            }
+        }
+
+        if (!result) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool LMMarkupAppendInstruction(LMMarkupDocumentRef document, LMMarkupJSON *json, LMMarkupSlice target, LMMarkupSlice data, uint32_t line)
+{
+    static const char kProperties[] = "properties";
+
+    // Pre-parse templates; anything that can't be represented is left for the builder to report
+    if (target.length == sizeof(kProperties) - 1 && memcmp(target.bytes, kProperties, target.length) == 0
+        && data.length > 0 && data.bytes[0] == '{') {
+        json->position = data.bytes;
+        json->end = data.bytes + data.length;
+
+        json->textLength = 0;
+        json->entryCount = 0;
+
+        if (LMMarkupJSONRead(json)) {
+            return LMMarkupAppendTemplates(document, json, line);
+        }
+
+        if (json->failed) {
+            return false;
+        }
+    }
+
+    uint32_t targetIndex = LMMarkupDocumentAddString(document, target.bytes, target.length);
+    uint32_t dataIndex = LMMarkupDocumentAddString(document, data.bytes, data.length);
+
+    return targetIndex != LMMarkupNone && dataIndex != LMMarkupNone
+        && LMMarkupDocumentAppendInstruction(document, targetIndex, dataIndex, line);
+}
+
+static bool LMMarkupAppendStartElement(LMMarkupDocumentRef document, LMMarkupReaderRef reader, uint32_t line)
+{
+    LMMarkupSlice name = LMMarkupReaderGetName(reader);
+
+    uint32_t nameIndex = LMMarkupDocumentAddString(document, name.bytes, name.length);
+
+    if (nameIndex == LMMarkupNone || !LMMarkupDocumentAppendStartElement(document, nameIndex, line)) {
+        return false;
+    }
+
+    for (uint32_t i = 0, n = LMMarkupReaderGetAttributeCount(reader); i < n; i++) {
+        const LMMarkupReaderAttribute *attribute = LMMarkupReaderGetAttribute(reader, i);
+
+        uint32_t keyIndex = LMMarkupDocumentAddString(document, attribute->key.bytes, attribute->key.length);
+        uint32_t valueIndex = LMMarkupDocumentAddString(document, attribute->value.bytes, attribute->value.length);
+
+        if (keyIndex == LMMarkupNone || valueIndex == LMMarkupNone
+            || !LMMarkupDocumentAppendAttribute(document, keyIndex, valueIndex)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+LMMarkupDocumentRef LMMarkupCompile(const void *bytes, size_t length, LMMarkupError *error, uint32_t *line, uint32_t *column)
+{
+    *error = LMMarkupErrorNone;
+    *line = 0;
+    *column = 0;
+
+    LMMarkupDocumentRef document = LMMarkupDocumentCreate();
+    LMMarkupReaderRef reader = LMMarkupReaderCreate(bytes, length);
+
+    LMMarkupJSON json = {0};
+
+    if (document == NULL || reader == NULL) {
+        *error = LMMarkupErrorMemory;
+    } else {
+        LMMarkupTokenType type;
+
+        while (*error == LMMarkupErrorNone && (type = LMMarkupReaderNext(reader)) != LMMarkupTokenEndOfDocument) {
+            uint32_t tokenLine = LMMarkupReaderGetLine(reader);
+
+            bool result;
+
+            switch (type) {
+                case LMMarkupTokenStartElement: {
+                    result = LMMarkupAppendStartElement(document, reader, tokenLine);
+
+                    break;
+                }
+
+                case LMMarkupTokenEndElement: {
+                    result = LMMarkupDocumentAppendEndElement(document, tokenLine);
+
+                    break;
+                }
+
+                case LMMarkupTokenInstruction: {
+                    result = LMMarkupAppendInstruction(document, &json, LMMarkupReaderGetName(reader), LMMarkupReaderGetData(reader), tokenLine);
+
+                    break;
+                }
+
+                default: {
+                    *error = LMMarkupReaderGetError(reader);
+                    *line = tokenLine;
+                    *column = LMMarkupReaderGetColumn(reader);
+
+                    result = true;
+
+                    break;
+                }
+            }
+
+            if (!result) {
+                *error = LMMarkupErrorMemory;
+            }
+        }
+    }
+
+    if (*error == LMMarkupErrorNone) {
+        LMMarkupDocumentSetSource(document, bytes, length);
+    } else {
+        LMMarkupDocumentRelease(document);
+
+        document = NULL;
+    }
+
+    LMMarkupReaderRelease(reader);
+
+    free(json.text);
+    free(json.entries);
+
+    return document;
+}
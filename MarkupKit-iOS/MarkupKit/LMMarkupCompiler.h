@@ -0,0 +1,45 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef LMMarkupCompiler_h
+#define LMMarkupCompiler_h
+
+#include "LMMarkupDocument.h"
+#include "LMMarkupReader.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Compiles markup into a document. Property templates whose JSON consists only of
+ * string, number, boolean, and null values are pre-parsed; all other processing
+ * instructions are stored as-is. The length and hash of the markup are recorded
+ * so that a stale encoded document can be detected.
+ *
+ * @param bytes The markup to compile.
+ * @param length The length of the markup in bytes.
+ * @param error On return, the error that was encountered, if any.
+ * @param line On return, the line at which the error occurred.
+ * @param column On return, the column at which the error occurred.
+ *
+ * @return The compiled document, or <code>NULL</code> if the markup could not be compiled.
+ */
+LMMarkupDocumentRef LMMarkupCompile(const void *bytes, size_t length, LMMarkupError *error, uint32_t *line, uint32_t *column);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
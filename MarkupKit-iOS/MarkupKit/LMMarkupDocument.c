@@ -0,0 +1,881 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "LMMarkupDocument.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+struct __LMMarkupDocument {
+    char *pool;
+    size_t poolLength;
+    size_t poolCapacity;
+
+    uint32_t *offsets;
+    uint32_t stringCount;
+    uint32_t stringCapacity;
+
+    uint32_t *table;
+    uint32_t tableCapacity;
+
+    LMMarkupNode *nodes;
+    uint32_t nodeCount;
+    uint32_t nodeCapacity;
+
+    LMMarkupAttribute *attributes;
+    uint32_t attributeCount;
+    uint32_t attributeCapacity;
+
+    LMMarkupTemplate *templates;
+    uint32_t templateCount;
+    uint32_t templateCapacity;
+
+    LMMarkupProperty *properties;
+    uint32_t propertyCount;
+    uint32_t propertyCapacity;
+
+    uint64_t sourceLength;
+    uint64_t sourceHash;
+};
+
+// Encoded form: a fixed header followed by the string offsets, the string pool (padded
+// to a 4-byte boundary), and the node, attribute, template, and property arrays. The
+// header ends with the length and hash of the markup the document was compiled from.
+// All integers are little-endian.
+static const uint8_t kMagic[4] = {'L', 'M', 'K', 'B'};
+
+static const uint32_t kVersion = 2;
+
+static const size_t kHeaderSize = 48;
+
+// Source length of a document whose source is not known
+static const uint64_t kUnknownSource = UINT64_MAX;
+
+static const size_t kNodeSize = 24;
+static const size_t kAttributeSize = 8;
+static const size_t kTemplateSize = 12;
+static const size_t kPropertySize = 20;
+
+static uint32_t LMMarkupHash(const char *bytes, size_t length)
+{
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)bytes[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static uint64_t LMMarkupSourceHash(const uint8_t *bytes, size_t length)
+{
+    uint64_t hash = 14695981039346656037u;
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211u;
+    }
+
+    return hash;
+}
+
+static bool LMMarkupReserve(void **buffer, uint32_t *capacity, uint32_t count, size_t size)
+{
+    if (count < *capacity) {
+        return true;
+    }
+
+    if (count == LMMarkupNone) {
+        return false;
+    }
+
+    uint32_t newCapacity = (*capacity < 8) ? 8 : *capacity;
+
+    while (newCapacity <= count) {
+        newCapacity = (newCapacity > UINT32_MAX / 2) ? UINT32_MAX - 1 : newCapacity * 2;
+    }
+
+    void *newBuffer = realloc(*buffer, (size_t)newCapacity * size);
+
+    if (newBuffer == NULL) {
+        return false;
+    }
+
+    *buffer = newBuffer;
+    *capacity = newCapacity;
+
+    return true;
+}
+
+static size_t LMMarkupStringLength(LMMarkupDocumentRef document, uint32_t index)
+{
+    size_t end = (index + 1 < document->stringCount) ? document->offsets[index + 1] : document->poolLength;
+
+    return end - document->offsets[index] - 1;
+}
+
+static bool LMMarkupRehash(LMMarkupDocumentRef document, uint32_t capacity)
+{
+    uint32_t *table = calloc(capacity, sizeof(uint32_t));
+
+    if (table == NULL) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < document->stringCount; i++) {
+        uint32_t slot = LMMarkupHash(document->pool + document->offsets[i], LMMarkupStringLength(document, i)) & (capacity - 1);
+
+        while (table[slot] != 0) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+
+        table[slot] = i + 1;
+    }
+
+    free(document->table);
+
+    document->table = table;
+    document->tableCapacity = capacity;
+
+    return true;
+}
+
+LMMarkupDocumentRef LMMarkupDocumentCreate(void)
+{
+    LMMarkupDocumentRef document = calloc(1, sizeof(struct __LMMarkupDocument));
+
+    if (document != NULL) {
+        document->sourceLength = kUnknownSource;
+    }
+
+    return document;
+}
+
+void LMMarkupDocumentRelease(LMMarkupDocumentRef document)
+{
+    if (document == NULL) {
+        return;
+    }
+
+    free(document->pool);
+    free(document->offsets);
+    free(document->table);
+    free(document->nodes);
+    free(document->attributes);
+    free(document->templates);
+    free(document->properties);
+
+    free(document);
+}
+
+uint32_t LMMarkupDocumentAddString(LMMarkupDocumentRef document, const char *bytes, size_t length)
+{
+    if (length >= UINT32_MAX - document->poolLength) {
+        return LMMarkupNone;
+    }
+
+    // Keep the table at most half full
+    if ((document->stringCount + 1) * 2 > document->tableCapacity) {
+        uint32_t capacity = (document->tableCapacity == 0) ? 64 : document->tableCapacity;
+
+        while ((document->stringCount + 1) * 2 > capacity) {
+            capacity *= 2;
+        }
+
+        if (!LMMarkupRehash(document, capacity)) {
+            return LMMarkupNone;
+        }
+    }
+
+    uint32_t slot = LMMarkupHash(bytes, length) & (document->tableCapacity - 1);
+
+    while (document->table[slot] != 0) {
+        uint32_t index = document->table[slot] - 1;
+
+        if (LMMarkupStringLength(document, index) == length
+            && memcmp(document->pool + document->offsets[index], bytes, length) == 0) {
+            return index;
+        }
+
+        slot = (slot + 1) & (document->tableCapacity - 1);
+    }
+
+    if (!LMMarkupReserve((void **)&document->offsets, &document->stringCapacity, document->stringCount, sizeof(uint32_t))) {
+        return LMMarkupNone;
+    }
+
+    if (document->poolLength + length + 1 > document->poolCapacity) {
+        size_t capacity = (document->poolCapacity < 256) ? 256 : document->poolCapacity;
+
+        while (document->poolLength + length + 1 > capacity) {
+            capacity *= 2;
+        }
+
+        char *pool = realloc(document->pool, capacity);
+
+        if (pool == NULL) {
+            return LMMarkupNone;
+        }
+
+        document->pool = pool;
+        document->poolCapacity = capacity;
+    }
+
+    uint32_t index = document->stringCount++;
+
+    document->offsets[index] = (uint32_t)document->poolLength;
+
+    memcpy(document->pool + document->poolLength, bytes, length);
+
+    document->pool[document->poolLength + length] = '\0';
+    document->poolLength += length + 1;
+
+    document->table[slot] = index + 1;
+
+    return index;
+}
+
+static LMMarkupNode *LMMarkupAppendNode(LMMarkupDocumentRef document, LMMarkupNodeType type, uint32_t line)
+{
+    if (!LMMarkupReserve((void **)&document->nodes, &document->nodeCapacity, document->nodeCount, sizeof(LMMarkupNode))) {
+        return NULL;
+    }
+
+    LMMarkupNode *node = &document->nodes[document->nodeCount++];
+
+    node->type = type;
+    node->name = LMMarkupNone;
+    node->data = LMMarkupNone;
+    node->first = 0;
+    node->count = 0;
+    node->line = line;
+
+    return node;
+}
+
+bool LMMarkupDocumentAppendStartElement(LMMarkupDocumentRef document, uint32_t name, uint32_t line)
+{
+    LMMarkupNode *node = LMMarkupAppendNode(document, LMMarkupNodeStartElement, line);
+
+    if (node == NULL) {
+        return false;
+    }
+
+    node->name = name;
+    node->first = document->attributeCount;
+
+    return true;
+}
+
+bool LMMarkupDocumentAppendAttribute(LMMarkupDocumentRef document, uint32_t key, uint32_t value)
+{
+    if (document->nodeCount == 0 || document->nodes[document->nodeCount - 1].type != LMMarkupNodeStartElement) {
+        return false;
+    }
+
+    if (!LMMarkupReserve((void **)&document->attributes, &document->attributeCapacity, document->attributeCount, sizeof(LMMarkupAttribute))) {
+        return false;
+    }
+
+    LMMarkupAttribute *attribute = &document->attributes[document->attributeCount++];
+
+    attribute->key = key;
+    attribute->value = value;
+
+    document->nodes[document->nodeCount - 1].count++;
+
+    return true;
+}
+
+bool LMMarkupDocumentAppendEndElement(LMMarkupDocumentRef document, uint32_t line)
+{
+    return LMMarkupAppendNode(document, LMMarkupNodeEndElement, line) != NULL;
+}
+
+bool LMMarkupDocumentAppendInstruction(LMMarkupDocumentRef document, uint32_t target, uint32_t data, uint32_t line)
+{
+    LMMarkupNode *node = LMMarkupAppendNode(document, LMMarkupNodeInstruction, line);
+
+    if (node == NULL) {
+        return false;
+    }
+
+    node->name = target;
+    node->data = data;
+
+    return true;
+}
+
+bool LMMarkupDocumentAppendProperties(LMMarkupDocumentRef document, uint32_t line)
+{
+    LMMarkupNode *node = LMMarkupAppendNode(document, LMMarkupNodeProperties, line);
+
+    if (node == NULL) {
+        return false;
+    }
+
+    node->first = document->templateCount;
+
+    return true;
+}
+
+bool LMMarkupDocumentAppendTemplate(LMMarkupDocumentRef document, uint32_t name)
+{
+    if (document->nodeCount == 0 || document->nodes[document->nodeCount - 1].type != LMMarkupNodeProperties) {
+        return false;
+    }
+
+    if (!LMMarkupReserve((void **)&document->templates, &document->templateCapacity, document->templateCount, sizeof(LMMarkupTemplate))) {
+        return false;
+    }
+
+    LMMarkupTemplate *template = &document->templates[document->templateCount++];
+
+    template->name = name;
+    template->first = document->propertyCount;
+    template->count = 0;
+
+    document->nodes[document->nodeCount - 1].count++;
+
+    return true;
+}
+
+bool LMMarkupDocumentAppendProperty(LMMarkupDocumentRef document, uint32_t key, LMMarkupValueType type, uint32_t string, double number)
+{
+    if (document->templateCount == 0) {
+        return false;
+    }
+
+    if (!LMMarkupReserve((void **)&document->properties, &document->propertyCapacity, document->propertyCount, sizeof(LMMarkupProperty))) {
+        return false;
+    }
+
+    LMMarkupProperty *property = &document->properties[document->propertyCount++];
+
+    property->key = key;
+    property->type = type;
+    property->string = (type == LMMarkupValueString) ? string : LMMarkupNone;
+    property->number = (type == LMMarkupValueNumber || type == LMMarkupValueBoolean) ? number : 0;
+
+    document->templates[document->templateCount - 1].count++;
+
+    return true;
+}
+
+bool LMMarkupDocumentAppendIntegerProperty(LMMarkupDocumentRef document, uint32_t key, int64_t integer)
+{
+    if (!LMMarkupDocumentAppendProperty(document, key, LMMarkupValueInteger, LMMarkupNone, 0)) {
+        return false;
+    }
+
+    document->properties[document->propertyCount - 1].integer = integer;
+
+    return true;
+}
+
+uint32_t LMMarkupDocumentGetStringCount(LMMarkupDocumentRef document)
+{
+    return document->stringCount;
+}
+
+const char *LMMarkupDocumentGetString(LMMarkupDocumentRef document, uint32_t index, size_t *length)
+{
+    if (length != NULL) {
+        *length = LMMarkupStringLength(document, index);
+    }
+
+    return document->pool + document->offsets[index];
+}
+
+uint32_t LMMarkupDocumentGetNodeCount(LMMarkupDocumentRef document)
+{
+    return document->nodeCount;
+}
+
+const LMMarkupNode *LMMarkupDocumentGetNode(LMMarkupDocumentRef document, uint32_t index)
+{
+    return &document->nodes[index];
+}
+
+const LMMarkupAttribute *LMMarkupDocumentGetAttribute(LMMarkupDocumentRef document, uint32_t index)
+{
+    return &document->attributes[index];
+}
+
+const LMMarkupTemplate *LMMarkupDocumentGetTemplate(LMMarkupDocumentRef document, uint32_t index)
+{
+    return &document->templates[index];
+}
+
+const LMMarkupProperty *LMMarkupDocumentGetProperty(LMMarkupDocumentRef document, uint32_t index)
+{
+    return &document->properties[index];
+}
+
+void LMMarkupDocumentSetSource(LMMarkupDocumentRef document, const void *bytes, size_t length)
+{
+    document->sourceLength = length;
+    document->sourceHash = LMMarkupSourceHash(bytes, length);
+}
+
+bool LMMarkupDocumentMatchesSource(LMMarkupDocumentRef document, const void *bytes, size_t length)
+{
+    if (document->sourceLength == kUnknownSource) {
+        return true;
+    }
+
+    return document->sourceLength == length && document->sourceHash == LMMarkupSourceHash(bytes, length);
+}
+
+size_t LMMarkupDocumentGetSize(LMMarkupDocumentRef document)
+{
+    return sizeof(struct __LMMarkupDocument)
+        + document->poolCapacity
+        + (size_t)document->stringCapacity * sizeof(uint32_t)
+        + (size_t)document->tableCapacity * sizeof(uint32_t)
+        + (size_t)document->nodeCapacity * sizeof(LMMarkupNode)
+        + (size_t)document->attributeCapacity * sizeof(LMMarkupAttribute)
+        + (size_t)document->templateCapacity * sizeof(LMMarkupTemplate)
+        + (size_t)document->propertyCapacity * sizeof(LMMarkupProperty);
+}
+
+static uint8_t *LMMarkupWrite32(uint8_t *bytes, uint32_t value)
+{
+    bytes[0] = (uint8_t)value;
+    bytes[1] = (uint8_t)(value >> 8);
+    bytes[2] = (uint8_t)(value >> 16);
+    bytes[3] = (uint8_t)(value >> 24);
+
+    return bytes + 4;
+}
+
+static uint8_t *LMMarkupWrite64(uint8_t *bytes, uint64_t value)
+{
+    bytes = LMMarkupWrite32(bytes, (uint32_t)value);
+    bytes = LMMarkupWrite32(bytes, (uint32_t)(value >> 32));
+
+    return bytes;
+}
+
+static uint32_t LMMarkupRead32(const uint8_t *bytes)
+{
+    return (uint32_t)bytes[0]
+        | ((uint32_t)bytes[1] << 8)
+        | ((uint32_t)bytes[2] << 16)
+        | ((uint32_t)bytes[3] << 24);
+}
+
+static uint64_t LMMarkupRead64(const uint8_t *bytes)
+{
+    return (uint64_t)LMMarkupRead32(bytes) | ((uint64_t)LMMarkupRead32(bytes + 4) << 32);
+}
+
+static size_t LMMarkupPad(size_t length)
+{
+    return (length + 3) & ~(size_t)3;
+}
+
+void *LMMarkupDocumentEncode(LMMarkupDocumentRef document, size_t *length)
+{
+    uint64_t size = kHeaderSize
+        + (uint64_t)document->stringCount * 4
+        + LMMarkupPad(document->poolLength)
+        + (uint64_t)document->nodeCount * kNodeSize
+        + (uint64_t)document->attributeCount * kAttributeSize
+        + (uint64_t)document->templateCount * kTemplateSize
+        + (uint64_t)document->propertyCount * kPropertySize;
+
+    if (size > SIZE_MAX) {
+        return NULL;
+    }
+
+    uint8_t *buffer = calloc(1, (size_t)size);
+
+    if (buffer == NULL) {
+        return NULL;
+    }
+
+    uint8_t *bytes = buffer;
+
+    memcpy(bytes, kMagic, sizeof(kMagic));
+
+    bytes += sizeof(kMagic);
+
+    bytes = LMMarkupWrite32(bytes, kVersion);
+    bytes = LMMarkupWrite32(bytes, document->stringCount);
+    bytes = LMMarkupWrite32(bytes, (uint32_t)document->poolLength);
+    bytes = LMMarkupWrite32(bytes, document->nodeCount);
+    bytes = LMMarkupWrite32(bytes, document->attributeCount);
+    bytes = LMMarkupWrite32(bytes, document->templateCount);
+    bytes = LMMarkupWrite32(bytes, document->propertyCount);
+    bytes = LMMarkupWrite64(bytes, document->sourceLength);
+    bytes = LMMarkupWrite64(bytes, document->sourceHash);
+
+    for (uint32_t i = 0; i < document->stringCount; i++) {
+        bytes = LMMarkupWrite32(bytes, document->offsets[i]);
+    }
+
+    if (document->poolLength > 0) {
+        memcpy(bytes, document->pool, document->poolLength);
+    }
+
+    bytes += LMMarkupPad(document->poolLength);
+
+    for (uint32_t i = 0; i < document->nodeCount; i++) {
+        const LMMarkupNode *node = &document->nodes[i];
+
+        bytes = LMMarkupWrite32(bytes, node->type);
+        bytes = LMMarkupWrite32(bytes, node->name);
+        bytes = LMMarkupWrite32(bytes, node->data);
+        bytes = LMMarkupWrite32(bytes, node->first);
+        bytes = LMMarkupWrite32(bytes, node->count);
+        bytes = LMMarkupWrite32(bytes, node->line);
+    }
+
+    for (uint32_t i = 0; i < document->attributeCount; i++) {
+        const LMMarkupAttribute *attribute = &document->attributes[i];
+
+        bytes = LMMarkupWrite32(bytes, attribute->key);
+        bytes = LMMarkupWrite32(bytes, attribute->value);
+    }
+
+    for (uint32_t i = 0; i < document->templateCount; i++) {
+        const LMMarkupTemplate *template = &document->templates[i];
+
+        bytes = LMMarkupWrite32(bytes, template->name);
+        bytes = LMMarkupWrite32(bytes, template->first);
+        bytes = LMMarkupWrite32(bytes, template->count);
+    }
+
+    for (uint32_t i = 0; i < document->propertyCount; i++) {
+        const LMMarkupProperty *property = &document->properties[i];
+
+        uint64_t number;
+        memcpy(&number, &property->number, sizeof(number));
+
+        bytes = LMMarkupWrite32(bytes, property->key);
+        bytes = LMMarkupWrite32(bytes, property->type);
+        bytes = LMMarkupWrite32(bytes, property->string);
+        bytes = LMMarkupWrite64(bytes, number);
+    }
+
+    *length = (size_t)size;
+
+    return buffer;
+}
+
+static bool LMMarkupIsRange(uint32_t first, uint32_t count, uint32_t limit)
+{
+    return first <= limit && count <= limit - first;
+}
+
+static bool LMMarkupIsUTF8(const uint8_t *bytes, size_t length)
+{
+    const uint8_t *p = bytes, *end = bytes + length;
+
+    while (p < end) {
+        if (*p < 0x80) {
+            p++;
+
+            continue;
+        }
+
+        uint32_t c;
+        size_t count;
+        uint32_t minimum;
+        if ((*p & 0xE0) == 0xC0) {
+            c = *p & 0x1F;
+            count = 2;
+            minimum = 0x80;
+        } else if ((*p & 0xF0) == 0xE0) {
+            c = *p & 0x0F;
+            count = 3;
+            minimum = 0x800;
+        } else if ((*p & 0xF8) == 0xF0) {
+            c = *p & 0x07;
+            count = 4;
+            minimum = 0x10000;
+        } else {
+            return false;
+        }
+
+        if ((size_t)(end - p) < count) {
+            return false;
+        }
+
+        for (size_t i = 1; i < count; i++) {
+            if ((p[i] & 0xC0) != 0x80) {
+                return false;
+            }
+
+            c = (c << 6) | (p[i] & 0x3F);
+        }
+
+        if (c < minimum || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) {
+            return false;
+        }
+
+        p += count;
+    }
+
+    return true;
+}
+
+static bool LMMarkupValidate(LMMarkupDocumentRef document)
+{
+    // Strings
+    for (uint32_t i = 0; i < document->stringCount; i++) {
+        size_t start = document->offsets[i];
+        size_t end = (i + 1 < document->stringCount) ? document->offsets[i + 1] : document->poolLength;
+
+        if ((i == 0 && start != 0) || start >= end || end > document->poolLength || document->pool[end - 1] != '\0') {
+            return false;
+        }
+
+        // Strings must be valid UTF-8, since they are decoded as such when the document is loaded
+        if (!LMMarkupIsUTF8((const uint8_t *)document->pool + start, end - start - 1)) {
+            return false;
+        }
+    }
+
+    if (document->stringCount == 0 && document->poolLength != 0) {
+        return false;
+    }
+
+    // Nodes
+    uint32_t depth = 0;
+
+    for (uint32_t i = 0; i < document->nodeCount; i++) {
+        const LMMarkupNode *node = &document->nodes[i];
+
+        switch (node->type) {
+            case LMMarkupNodeStartElement: {
+                if (node->name >= document->stringCount || !LMMarkupIsRange(node->first, node->count, document->attributeCount)) {
+                    return false;
+                }
+
+                depth++;
+
+                break;
+            }
+
+            case LMMarkupNodeEndElement: {
+                if (depth == 0) {
+                    return false;
+                }
+
+                depth--;
+
+                break;
+            }
+
+            case LMMarkupNodeInstruction: {
+                if (node->name >= document->stringCount || node->data >= document->stringCount) {
+                    return false;
+                }
+
+                break;
+            }
+
+            case LMMarkupNodeProperties: {
+                if (!LMMarkupIsRange(node->first, node->count, document->templateCount)) {
+                    return false;
+                }
+
+                break;
+            }
+
+            default: {
+                return false;
+            }
+        }
+    }
+
+    if (depth != 0) {
+        return false;
+    }
+
+    // Attributes
+    for (uint32_t i = 0; i < document->attributeCount; i++) {
+        const LMMarkupAttribute *attribute = &document->attributes[i];
+
+        if (attribute->key >= document->stringCount || attribute->value >= document->stringCount) {
+            return false;
+        }
+    }
+
+    // Templates
+    for (uint32_t i = 0; i < document->templateCount; i++) {
+        const LMMarkupTemplate *template = &document->templates[i];
+
+        if (template->name >= document->stringCount || !LMMarkupIsRange(template->first, template->count, document->propertyCount)) {
+            return false;
+        }
+    }
+
+    // Properties
+    for (uint32_t i = 0; i < document->propertyCount; i++) {
+        const LMMarkupProperty *property = &document->properties[i];
+
+        if (property->key >= document->stringCount) {
+            return false;
+        }
+
+        switch (property->type) {
+            case LMMarkupValueString: {
+                if (property->string >= document->stringCount) {
+                    return false;
+                }
+
+                break;
+            }
+
+            case LMMarkupValueNull:
+            case LMMarkupValueNumber:
+            case LMMarkupValueBoolean:
+            case LMMarkupValueInteger: {
+                if (property->string != LMMarkupNone) {
+                    return false;
+                }
+
+                break;
+            }
+
+            default: {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+LMMarkupDocumentRef LMMarkupDocumentDecode(const void *bytes, size_t length)
+{
+    const uint8_t *buffer = bytes;
+
+    if (length < kHeaderSize || memcmp(buffer, kMagic, sizeof(kMagic)) != 0 || LMMarkupRead32(buffer + 4) != kVersion) {
+        return NULL;
+    }
+
+    uint32_t stringCount = LMMarkupRead32(buffer + 8);
+    uint32_t poolLength = LMMarkupRead32(buffer + 12);
+    uint32_t nodeCount = LMMarkupRead32(buffer + 16);
+    uint32_t attributeCount = LMMarkupRead32(buffer + 20);
+    uint32_t templateCount = LMMarkupRead32(buffer + 24);
+    uint32_t propertyCount = LMMarkupRead32(buffer + 28);
+    uint64_t sourceLength = LMMarkupRead64(buffer + 32);
+    uint64_t sourceHash = LMMarkupRead64(buffer + 40);
+
+    uint64_t size = kHeaderSize
+        + (uint64_t)stringCount * 4
+        + LMMarkupPad(poolLength)
+        + (uint64_t)nodeCount * kNodeSize
+        + (uint64_t)attributeCount * kAttributeSize
+        + (uint64_t)templateCount * kTemplateSize
+        + (uint64_t)propertyCount * kPropertySize;
+
+    if (size != length) {
+        return NULL;
+    }
+
+    LMMarkupDocumentRef document = LMMarkupDocumentCreate();
+
+    if (document == NULL) {
+        return NULL;
+    }
+
+    document->offsets = malloc((size_t)stringCount * sizeof(uint32_t) + 1);
+    document->pool = malloc((size_t)poolLength + 1);
+    document->nodes = malloc((size_t)nodeCount * sizeof(LMMarkupNode) + 1);
+    document->attributes = malloc((size_t)attributeCount * sizeof(LMMarkupAttribute) + 1);
+    document->templates = malloc((size_t)templateCount * sizeof(LMMarkupTemplate) + 1);
+    document->properties = malloc((size_t)propertyCount * sizeof(LMMarkupProperty) + 1);
+
+    if (document->offsets == NULL || document->pool == NULL || document->nodes == NULL
+        || document->attributes == NULL || document->templates == NULL || document->properties == NULL) {
+        LMMarkupDocumentRelease(document);
+
+        return NULL;
+    }
+
+    document->stringCount = document->stringCapacity = stringCount;
+    document->poolLength = document->poolCapacity = poolLength;
+    document->nodeCount = document->nodeCapacity = nodeCount;
+    document->attributeCount = document->attributeCapacity = attributeCount;
+    document->templateCount = document->templateCapacity = templateCount;
+    document->propertyCount = document->propertyCapacity = propertyCount;
+
+    document->sourceLength = sourceLength;
+    document->sourceHash = sourceHash;
+
+    buffer += kHeaderSize;
+
+    for (uint32_t i = 0; i < stringCount; i++, buffer += 4) {
+        document->offsets[i] = LMMarkupRead32(buffer);
+    }
+
+    if (poolLength > 0) {
+        memcpy(document->pool, buffer, poolLength);
+    }
+
+    buffer += LMMarkupPad(poolLength);
+
+    for (uint32_t i = 0; i < nodeCount; i++, buffer += kNodeSize) {
+        LMMarkupNode *node = &document->nodes[i];
+
+        node->type = LMMarkupRead32(buffer);
+        node->name = LMMarkupRead32(buffer + 4);
+        node->data = LMMarkupRead32(buffer + 8);
+        node->first = LMMarkupRead32(buffer + 12);
+        node->count = LMMarkupRead32(buffer + 16);
+        node->line = LMMarkupRead32(buffer + 20);
+    }
+
+    for (uint32_t i = 0; i < attributeCount; i++, buffer += kAttributeSize) {
+        LMMarkupAttribute *attribute = &document->attributes[i];
+
+        attribute->key = LMMarkupRead32(buffer);
+        attribute->value = LMMarkupRead32(buffer + 4);
+    }
+
+    for (uint32_t i = 0; i < templateCount; i++, buffer += kTemplateSize) {
+        LMMarkupTemplate *template = &document->templates[i];
+
+        template->name = LMMarkupRead32(buffer);
+        template->first = LMMarkupRead32(buffer + 4);
+        template->count = LMMarkupRead32(buffer + 8);
+    }
+
+    for (uint32_t i = 0; i < propertyCount; i++, buffer += kPropertySize) {
+        LMMarkupProperty *property = &document->properties[i];
+
+        uint64_t number = LMMarkupRead64(buffer + 12);
+
+        property->key = LMMarkupRead32(buffer);
+        property->type = LMMarkupRead32(buffer + 4);
+        property->string = LMMarkupRead32(buffer + 8);
+
+        memcpy(&property->number, &number, sizeof(number));
+    }
+
+    if (!LMMarkupValidate(document)) {
+        LMMarkupDocumentRelease(document);
+
+        return NULL;
+    }
+
+    return document;
+}
@@ -0,0 +1,307 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef LMMarkupDocument_h
+#define LMMarkupDocument_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Index value representing the absence of a string.
+ */
+#define LMMarkupNone UINT32_MAX
+
+/**
+ * Markup node types.
+ */
+typedef enum {
+    LMMarkupNodeStartElement = 1,
+    LMMarkupNodeEndElement = 2,
+    LMMarkupNodeInstruction = 3,
+    LMMarkupNodeProperties = 4
+} LMMarkupNodeType;
+
+/**
+ * Markup value types.
+ */
+typedef enum {
+    LMMarkupValueNull = 0,
+    LMMarkupValueString = 1,
+    LMMarkupValueNumber = 2,
+    LMMarkupValueBoolean = 3,
+    LMMarkupValueInteger = 4
+} LMMarkupValueType;
+
+/**
+ * Markup node. Start elements refer to a range of attributes, and property nodes
+ * refer to a range of templates. Instruction nodes carry a target and data string.
+ */
+typedef struct {
+    uint32_t type;
+    uint32_t name;
+    uint32_t data;
+    uint32_t first;
+    uint32_t count;
+    uint32_t line;
+} LMMarkupNode;
+
+/**
+ * Element attribute.
+ */
+typedef struct {
+    uint32_t key;
+    uint32_t value;
+} LMMarkupAttribute;
+
+/**
+ * Property template. Templates refer to a range of properties.
+ */
+typedef struct {
+    uint32_t name;
+    uint32_t first;
+    uint32_t count;
+} LMMarkupTemplate;
+
+/**
+ * Template property. Integer values are stored separately from floating-point values
+ * so that they keep their full precision.
+ */
+typedef struct {
+    uint32_t key;
+    uint32_t type;
+    uint32_t string;
+    union {
+        double number;
+        int64_t integer;
+    };
+} LMMarkupProperty;
+
+/**
+ * Markup document. A document is a flat stream of nodes that refer to an interned
+ * string table, and can be encoded to and decoded from a compact binary form.
+ */
+typedef struct __LMMarkupDocument *LMMarkupDocumentRef;
+
+/**
+ * Creates an empty document.
+ *
+ * @return The new document, or <code>NULL</code> if the document could not be allocated.
+ */
+LMMarkupDocumentRef LMMarkupDocumentCreate(void);
+
+/**
+ * Releases a document.
+ *
+ * @param document The document to release.
+ */
+void LMMarkupDocumentRelease(LMMarkupDocumentRef document);
+
+/**
+ * Adds a string to the document's string table. Equal strings share a single index.
+ *
+ * @param document The document.
+ * @param bytes The string's UTF-8 bytes.
+ * @param length The length of the string in bytes.
+ *
+ * @return The index of the string, or <code>LMMarkupNone</code> if the string could not be added.
+ */
+uint32_t LMMarkupDocumentAddString(LMMarkupDocumentRef document, const char *bytes, size_t length);
+
+/**
+ * Appends a start element node.
+ *
+ * @param document The document.
+ * @param name The index of the element's tag.
+ * @param line The line number of the element.
+ *
+ * @return <code>true</code> if the node was appended; <code>false</code>, otherwise.
+ */
+bool LMMarkupDocumentAppendStartElement(LMMarkupDocumentRef document, uint32_t name, uint32_t line);
+
+/**
+ * Appends an attribute to the most recently appended start element.
+ *
+ * @param document The document.
+ * @param key The index of the attribute's key.
+ * @param value The index of the attribute's value.
+ *
+ * @return <code>true</code> if the attribute was appended; <code>false</code>, otherwise.
+ */
+bool LMMarkupDocumentAppendAttribute(LMMarkupDocumentRef document, uint32_t key, uint32_t value);
+
+/**
+ * Appends an end element node.
+ *
+ * @param document The document.
+ * @param line The line number of the element.
+ *
+ * @return <code>true</code> if the node was appended; <code>false</code>, otherwise.
+ */
+bool LMMarkupDocumentAppendEndElement(LMMarkupDocumentRef document, uint32_t line);
+
+/**
+ * Appends a processing instruction node.
+ *
+ * @param document The document.
+ * @param target The index of the instruction's target.
+ * @param data The index of the instruction's data.
+ * @param line The line number of the instruction.
+ *
+ * @return <code>true</code> if the node was appended; <code>false</code>, otherwise.
+ */
+bool LMMarkupDocumentAppendInstruction(LMMarkupDocumentRef document, uint32_t target, uint32_t data, uint32_t line);
+
+/**
+ * Appends a properties node.
+ *
+ * @param document The document.
+ * @param line The line number of the properties instruction.
+ *
+ * @return <code>true</code> if the node was appended; <code>false</code>, otherwise.
+ */
+bool LMMarkupDocumentAppendProperties(LMMarkupDocumentRef document, uint32_t line);
+
+/**
+ * Appends a template to the most recently appended properties node.
+ *
+ * @param document The document.
+ * @param name The index of the template's name.
+ *
+ * @return <code>true</code> if the template was appended; <code>false</code>, otherwise.
+ */
+bool LMMarkupDocumentAppendTemplate(LMMarkupDocumentRef document, uint32_t name);
+
+/**
+ * Appends a property to the most recently appended template.
+ *
+ * @param document The document.
+ * @param key The index of the property's key.
+ * @param type The property's value type.
+ * @param string The index of the property's string value, or <code>LMMarkupNone</code>.
+ * @param number The property's numeric or boolean value.
+ *
+ * @return <code>true</code> if the property was appended; <code>false</code>, otherwise.
+ */
+bool LMMarkupDocumentAppendProperty(LMMarkupDocumentRef document, uint32_t key, LMMarkupValueType type, uint32_t string, double number);
+
+/**
+ * Appends an integer property to the most recently appended template.
+ *
+ * @param document The document.
+ * @param key The index of the property's key.
+ * @param integer The property's value.
+ *
+ * @return <code>true</code> if the property was appended; <code>false</code>, otherwise.
+ */
+bool LMMarkupDocumentAppendIntegerProperty(LMMarkupDocumentRef document, uint32_t key, int64_t integer);
+
+/**
+ * Returns the number of strings in a document.
+ */
+uint32_t LMMarkupDocumentGetStringCount(LMMarkupDocumentRef document);
+
+/**
+ * Returns a string. Strings are null-terminated.
+ *
+ * @param document The document.
+ * @param index The index of the string.
+ * @param length On return, the length of the string in bytes.
+ */
+const char *LMMarkupDocumentGetString(LMMarkupDocumentRef document, uint32_t index, size_t *length);
+
+/**
+ * Returns the number of nodes in a document.
+ */
+uint32_t LMMarkupDocumentGetNodeCount(LMMarkupDocumentRef document);
+
+/**
+ * Returns a node.
+ */
+const LMMarkupNode *LMMarkupDocumentGetNode(LMMarkupDocumentRef document, uint32_t index);
+
+/**
+ * Returns an attribute.
+ */
+const LMMarkupAttribute *LMMarkupDocumentGetAttribute(LMMarkupDocumentRef document, uint32_t index);
+
+/**
+ * Returns a template.
+ */
+const LMMarkupTemplate *LMMarkupDocumentGetTemplate(LMMarkupDocumentRef document, uint32_t index);
+
+/**
+ * Returns a template property.
+ */
+const LMMarkupProperty *LMMarkupDocumentGetProperty(LMMarkupDocumentRef document, uint32_t index);
+
+/**
+ * Records the markup from which a document was compiled. The length and a hash of the
+ * markup are stored with the encoded document.
+ *
+ * @param document The document.
+ * @param bytes The markup.
+ * @param length The length of the markup in bytes.
+ */
+void LMMarkupDocumentSetSource(LMMarkupDocumentRef document, const void *bytes, size_t length);
+
+/**
+ * Determines whether a document was compiled from the given markup. Documents whose
+ * source was not recorded match any markup.
+ *
+ * @param document The document.
+ * @param bytes The markup.
+ * @param length The length of the markup in bytes.
+ *
+ * @return <code>true</code> if the document matches the markup; <code>false</code>, otherwise.
+ */
+bool LMMarkupDocumentMatchesSource(LMMarkupDocumentRef document, const void *bytes, size_t length);
+
+/**
+ * Returns the number of bytes occupied by a document.
+ */
+size_t LMMarkupDocumentGetSize(LMMarkupDocumentRef document);
+
+/**
+ * Encodes a document.
+ *
+ * @param document The document to encode.
+ * @param length On return, the length of the encoded document in bytes.
+ *
+ * @return The encoded document, or <code>NULL</code> if the document could not be encoded.
+ * The caller is responsible for freeing the returned buffer.
+ */
+void *LMMarkupDocumentEncode(LMMarkupDocumentRef document, size_t *length);
+
+/**
+ * Decodes a document. The encoded form is fully validated, so malformed input
+ * never produces a document with out-of-range references or unbalanced elements.
+ *
+ * @param bytes The encoded document.
+ * @param length The length of the encoded document in bytes.
+ *
+ * @return The decoded document, or <code>NULL</code> if the input is not a valid encoded document.
+ */
+LMMarkupDocumentRef LMMarkupDocumentDecode(const void *bytes, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
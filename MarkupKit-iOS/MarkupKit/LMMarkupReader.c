@@ -0,0 +1,959 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "LMMarkupReader.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+struct __LMMarkupReader {
+    const char *start;
+    const char *end;
+    const char *position;
+
+    const char *linePosition;
+    const char *lineStart;
+    uint32_t lineNumber;
+
+    LMMarkupSlice name;
+    LMMarkupSlice data;
+
+    LMMarkupReaderAttribute *attributes;
+    uint32_t attributeCount;
+    uint32_t attributeCapacity;
+
+    size_t *valueOffsets;
+    uint32_t valueOffsetCapacity;
+
+    char *buffer;
+    size_t bufferLength;
+    size_t bufferCapacity;
+
+    LMMarkupSlice *elements;
+    uint32_t depth;
+    uint32_t elementCapacity;
+
+    bool validated;
+    bool root;
+    bool closeElement;
+
+    uint32_t line;
+    uint32_t column;
+
+    LMMarkupError error;
+};
+
+// Marks an attribute value that borrows from the input rather than the decoding buffer
+static const size_t kBorrowed = SIZE_MAX;
+
+static bool LMMarkupReaderIsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool LMMarkupReaderIsNameStart(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':' || (uint8_t)c >= 0x80;
+}
+
+static bool LMMarkupReaderIsName(char c)
+{
+    return LMMarkupReaderIsNameStart(c) || (c >= '0' && c <= '9') || c == '-' || c == '.';
+}
+
+static bool LMMarkupReaderHasPrefix(const char *p, const char *end, const char *prefix)
+{
+    size_t length = strlen(prefix);
+
+    return (size_t)(end - p) >= length && memcmp(p, prefix, length) == 0;
+}
+
+static const char *LMMarkupReaderSkipSpace(const char *p, const char *end)
+{
+    while (p < end && LMMarkupReaderIsSpace(*p)) {
+        p++;
+    }
+
+    return p;
+}
+
+static const char *LMMarkupReaderReadName(const char *p, const char *end)
+{
+    if (p == end || !LMMarkupReaderIsNameStart(*p)) {
+        return NULL;
+    }
+
+    do {
+        p++;
+    } while (p < end && LMMarkupReaderIsName(*p));
+
+    return p;
+}
+
+static void LMMarkupReaderCountLines(LMMarkupReaderRef reader, const char *position)
+{
+    // Line numbers are counted incrementally, so the cost is proportional to the size of the input
+    const char *p = reader->linePosition;
+
+    while (p < position) {
+        const char *newline = memchr(p, '\n', position - p);
+        const char *carriageReturn = memchr(p, '\r', ((newline == NULL) ? position : newline) - p);
+
+        if (carriageReturn != NULL) {
+            // A carriage return is a line break unless it is followed by a line feed
+            p = carriageReturn + 1;
+
+            if (p == reader->end || *p != '\n') {
+                reader->lineNumber++;
+                reader->lineStart = p;
+            }
+        } else if (newline != NULL) {
+            p = newline + 1;
+
+            reader->lineNumber++;
+            reader->lineStart = p;
+        } else {
+            p = position;
+        }
+    }
+
+    if (position > reader->linePosition) {
+        reader->linePosition = position;
+    }
+}
+
+static LMMarkupTokenType LMMarkupReaderFail(LMMarkupReaderRef reader, LMMarkupError error, const char *position)
+{
+    LMMarkupReaderCountLines(reader, position);
+
+    reader->error = error;
+
+    reader->line = reader->lineNumber;
+    reader->column = (uint32_t)(position - reader->lineStart) + 1;
+
+    reader->name = (LMMarkupSlice){reader->start, 0};
+    reader->data = (LMMarkupSlice){reader->start, 0};
+
+    reader->attributeCount = 0;
+
+    return LMMarkupTokenError;
+}
+
+static LMMarkupTokenType LMMarkupReaderToken(LMMarkupReaderRef reader, LMMarkupTokenType type, const char *position)
+{
+    LMMarkupReaderCountLines(reader, position);
+
+    reader->line = reader->lineNumber;
+    reader->column = (uint32_t)(position - reader->lineStart) + 1;
+
+    return type;
+}
+
+static bool LMMarkupReaderReserve(void **buffer, uint32_t *capacity, uint32_t count, size_t size)
+{
+    if (count < *capacity) {
+        return true;
+    }
+
+    if (count == UINT32_MAX) {
+        return false;
+    }
+
+    uint32_t newCapacity = (*capacity < 8) ? 8 : *capacity;
+
+    while (newCapacity <= count) {
+        newCapacity = (newCapacity > UINT32_MAX / 2) ? UINT32_MAX - 1 : newCapacity * 2;
+    }
+
+    void *newBuffer = realloc(*buffer, (size_t)newCapacity * size);
+
+    if (newBuffer == NULL) {
+        return false;
+    }
+
+    *buffer = newBuffer;
+    *capacity = newCapacity;
+
+    return true;
+}
+
+static bool LMMarkupReaderAppend(LMMarkupReaderRef reader, const char *bytes, size_t length)
+{
+    if (length == 0) {
+        return true;
+    }
+
+    if (reader->bufferCapacity - reader->bufferLength < length) {
+        size_t capacity = (reader->bufferCapacity < 256) ? 256 : reader->bufferCapacity;
+
+        while (capacity - reader->bufferLength < length) {
+            if (capacity > SIZE_MAX / 2) {
+                return false;
+            }
+
+            capacity *= 2;
+        }
+
+        char *buffer = realloc(reader->buffer, capacity);
+
+        if (buffer == NULL) {
+            return false;
+        }
+
+        reader->buffer = buffer;
+        reader->bufferCapacity = capacity;
+    }
+
+    memcpy(reader->buffer + reader->bufferLength, bytes, length);
+
+    reader->bufferLength += length;
+
+    return true;
+}
+
+static bool LMMarkupReaderAppendCharacter(LMMarkupReaderRef reader, uint32_t c)
+{
+    char bytes[4];
+    size_t length;
+
+    if (c < 0x80) {
+        bytes[0] = (char)c;
+        length = 1;
+    } else if (c < 0x800) {
+        bytes[0] = (char)(0xC0 | (c >> 6));
+        bytes[1] = (char)(0x80 | (c & 0x3F));
+        length = 2;
+    } else if (c < 0x10000) {
+        bytes[0] = (char)(0xE0 | (c >> 12));
+        bytes[1] = (char)(0x80 | ((c >> 6) & 0x3F));
+        bytes[2] = (char)(0x80 | (c & 0x3F));
+        length = 3;
+    } else {
+        bytes[0] = (char)(0xF0 | (c >> 18));
+        bytes[1] = (char)(0x80 | ((c >> 12) & 0x3F));
+        bytes[2] = (char)(0x80 | ((c >> 6) & 0x3F));
+        bytes[3] = (char)(0x80 | (c & 0x3F));
+        length = 4;
+    }
+
+    return LMMarkupReaderAppend(reader, bytes, length);
+}
+
+static bool LMMarkupReaderIsCharacter(uint32_t c)
+{
+    return c == 0x9 || c == 0xA || c == 0xD
+        || (c >= 0x20 && c <= 0xD7FF)
+        || (c >= 0xE000 && c <= 0xFFFD)
+        || (c >= 0x10000 && c <= 0x10FFFF);
+}
+
+static const char *LMMarkupReaderFindInvalidCharacter(const char *p, const char *end)
+{
+    // Returns the position of the first byte that does not begin a well-formed UTF-8 sequence
+    // encoding an XML character, or NULL if there is none
+    while (p < end) {
+        uint8_t b = (uint8_t)*p;
+
+        if (b < 0x80) {
+            if (b < 0x20 && b != '\t' && b != '\n' && b != '\r') {
+                return p;
+            }
+
+            p++;
+
+            continue;
+        }
+
+        uint32_t c;
+        size_t length;
+        uint32_t minimum;
+        if ((b & 0xE0) == 0xC0) {
+            c = b & 0x1F;
+            length = 2;
+            minimum = 0x80;
+        } else if ((b & 0xF0) == 0xE0) {
+            c = b & 0x0F;
+            length = 3;
+            minimum = 0x800;
+        } else if ((b & 0xF8) == 0xF0) {
+            c = b & 0x07;
+            length = 4;
+            minimum = 0x10000;
+        } else {
+            return p;
+        }
+
+        if ((size_t)(end - p) < length) {
+            return p;
+        }
+
+        for (size_t i = 1; i < length; i++) {
+            uint8_t continuation = (uint8_t)p[i];
+
+            if ((continuation & 0xC0) != 0x80) {
+                return p;
+            }
+
+            c = (c << 6) | (continuation & 0x3F);
+        }
+
+        // Overlong encodings, surrogates, and code points outside of the XML character range are rejected
+        if (c < minimum || !LMMarkupReaderIsCharacter(c)) {
+            return p;
+        }
+
+        p += length;
+    }
+
+    return NULL;
+}
+
+static const char *LMMarkupReaderDecodeReference(LMMarkupReaderRef reader, const char *p, const char *end, LMMarkupError *error)
+{
+    // p refers to the ampersand; returns the position following the semicolon
+    const char *semicolon = memchr(p, ';', end - p);
+
+    *error = LMMarkupErrorSyntax;
+
+    if (semicolon == NULL) {
+        return NULL;
+    }
+
+    const char *name = p + 1;
+    size_t length = semicolon - name;
+
+    if (length > 0 && name[0] == '#') {
+        uint32_t c = 0;
+
+        bool hexadecimal = (length > 1 && name[1] == 'x');
+
+        const char *digit = name + (hexadecimal ? 2 : 1);
+
+        if (digit == semicolon) {
+            return NULL;
+        }
+
+        for (; digit < semicolon; digit++) {
+            uint32_t value;
+
+            if (*digit >= '0' && *digit <= '9') {
+                value = (uint32_t)(*digit - '0');
+            } else if (hexadecimal && *digit >= 'a' && *digit <= 'f') {
+                value = (uint32_t)(*digit - 'a' + 10);
+            } else if (hexadecimal && *digit >= 'A' && *digit <= 'F') {
+                value = (uint32_t)(*digit - 'A' + 10);
+            } else {
+                return NULL;
+            }
+
+            c = c * (hexadecimal ? 16 : 10) + value;
+
+            if (c > 0x10FFFF) {
+                return NULL;
+            }
+        }
+
+        if (!LMMarkupReaderIsCharacter(c)) {
+            return NULL;
+        }
+
+        if (!LMMarkupReaderAppendCharacter(reader, c)) {
+            *error = LMMarkupErrorMemory;
+
+            return NULL;
+        }
+    } else {
+        char c;
+        if (length == 2 && memcmp(name, "lt", 2) == 0) {
+            c = '<';
+        } else if (length == 2 && memcmp(name, "gt", 2) == 0) {
+            c = '>';
+        } else if (length == 3 && memcmp(name, "amp", 3) == 0) {
+            c = '&';
+        } else if (length == 4 && memcmp(name, "quot", 4) == 0) {
+            c = '"';
+        } else if (length == 4 && memcmp(name, "apos", 4) == 0) {
+            c = '\'';
+        } else {
+            return NULL;
+        }
+
+        if (!LMMarkupReaderAppend(reader, &c, 1)) {
+            *error = LMMarkupErrorMemory;
+
+            return NULL;
+        }
+    }
+
+    *error = LMMarkupErrorNone;
+
+    return semicolon + 1;
+}
+
+static const char *LMMarkupReaderDecodeValue(LMMarkupReaderRef reader, const char *p, const char *end, LMMarkupError *error)
+{
+    // Resolves references and normalizes whitespace as required for attribute values;
+    // returns the position of the failure, or NULL on success
+    while (p < end) {
+        const char *run = p;
+
+        while (p < end && *p != '&' && *p != '\t' && *p != '\n' && *p != '\r') {
+            p++;
+        }
+
+        if (!LMMarkupReaderAppend(reader, run, p - run)) {
+            *error = LMMarkupErrorMemory;
+
+            return run;
+        }
+
+        if (p == end) {
+            break;
+        }
+
+        if (*p == '&') {
+            const char *next = LMMarkupReaderDecodeReference(reader, p, end, error);
+
+            if (next == NULL) {
+                return p;
+            }
+
+            p = next;
+        } else {
+            if (*p == '\r' && p + 1 < end && p[1] == '\n') {
+                p++;
+            }
+
+            p++;
+
+            if (!LMMarkupReaderAppend(reader, " ", 1)) {
+                *error = LMMarkupErrorMemory;
+
+                return p;
+            }
+        }
+    }
+
+    *error = LMMarkupErrorNone;
+
+    return NULL;
+}
+
+static LMMarkupTokenType LMMarkupReaderReadStartElement(LMMarkupReaderRef reader, const char *p)
+{
+    const char *end = reader->end;
+
+    if (reader->root && reader->depth == 0) {
+        return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, p);
+    }
+
+    const char *name = p + 1;
+    const char *nameEnd = LMMarkupReaderReadName(name, end);
+
+    if (nameEnd == NULL) {
+        return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, name);
+    }
+
+    reader->name = (LMMarkupSlice){name, nameEnd - name};
+
+    p = nameEnd;
+
+    bool empty;
+    for (;;) {
+        const char *q = LMMarkupReaderSkipSpace(p, end);
+
+        if (q == end) {
+            return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, q);
+        }
+
+        if (*q == '>') {
+            empty = false;
+            p = q;
+
+            break;
+        }
+
+        if (*q == '/') {
+            if (q + 1 == end || q[1] != '>') {
+                return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, q + 1);
+            }
+
+            empty = true;
+            p = q + 1;
+
+            break;
+        }
+
+        // Attributes must be separated from the name and from each other by whitespace
+        if (q == p) {
+            return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, q);
+        }
+
+        const char *key = q;
+        const char *keyEnd = LMMarkupReaderReadName(key, end);
+
+        if (keyEnd == NULL) {
+            return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, key);
+        }
+
+        q = LMMarkupReaderSkipSpace(keyEnd, end);
+
+        if (q == end || *q != '=') {
+            return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, q);
+        }
+
+        q = LMMarkupReaderSkipSpace(q + 1, end);
+
+        if (q == end || (*q != '"' && *q != '\'')) {
+            return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, q);
+        }
+
+        const char *value = q + 1;
+        const char *valueEnd = memchr(value, *q, end - value);
+
+        if (valueEnd == NULL) {
+            return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, end);
+        }
+
+        const char *lessThan = memchr(value, '<', valueEnd - value);
+
+        if (lessThan != NULL) {
+            return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, lessThan);
+        }
+
+        size_t keyLength = keyEnd - key;
+
+        for (uint32_t i = 0; i < reader->attributeCount; i++) {
+            LMMarkupSlice existingKey = reader->attributes[i].key;
+
+            if (existingKey.length == keyLength && memcmp(existingKey.bytes, key, keyLength) == 0) {
+                return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, key);
+            }
+        }
+
+        if (!LMMarkupReaderReserve((void **)&reader->attributes, &reader->attributeCapacity, reader->attributeCount, sizeof(LMMarkupReaderAttribute))
+            || !LMMarkupReaderReserve((void **)&reader->valueOffsets, &reader->valueOffsetCapacity, reader->attributeCount, sizeof(size_t))) {
+            return LMMarkupReaderFail(reader, LMMarkupErrorMemory, key);
+        }
+
+        LMMarkupReaderAttribute *attribute = &reader->attributes[reader->attributeCount];
+
+        attribute->key = (LMMarkupSlice){key, keyLength};
+
+        bool borrowed = true;
+
+        for (const char *c = value; c < valueEnd; c++) {
+            if (*c == '&' || *c == '\t' || *c == '\n' || *c == '\r') {
+                borrowed = false;
+
+                break;
+            }
+        }
+
+        if (borrowed) {
+            attribute->value = (LMMarkupSlice){value, valueEnd - value};
+
+            reader->valueOffsets[reader->attributeCount] = kBorrowed;
+        } else {
+            size_t offset = reader->bufferLength;
+
+            LMMarkupError error;
+            const char *failure = LMMarkupReaderDecodeValue(reader, value, valueEnd, &error);
+
+            if (failure != NULL) {
+                return LMMarkupReaderFail(reader, error, failure);
+            }
+
+            attribute->value = (LMMarkupSlice){NULL, reader->bufferLength - offset};
+
+            reader->valueOffsets[reader->attributeCount] = offset;
+        }
+
+        reader->attributeCount++;
+
+        p = valueEnd + 1;
+    }
+
+    // The decoding buffer may have moved while it grew, so decoded values are resolved last
+    for (uint32_t i = 0; i < reader->attributeCount; i++) {
+        if (reader->valueOffsets[i] != kBorrowed) {
+            reader->attributes[i].value.bytes = reader->buffer + reader->valueOffsets[i];
+        }
+    }
+
+    if (!LMMarkupReaderReserve((void **)&reader->elements, &reader->elementCapacity, reader->depth, sizeof(LMMarkupSlice))) {
+        return LMMarkupReaderFail(reader, LMMarkupErrorMemory, p);
+    }
+
+    reader->elements[reader->depth++] = reader->name;
+
+    reader->root = true;
+    reader->closeElement = empty;
+
+    reader->position = p + 1;
+
+    return LMMarkupReaderToken(reader, LMMarkupTokenStartElement, p);
+}
+
+static LMMarkupTokenType LMMarkupReaderReadEndElement(LMMarkupReaderRef reader, const char *p)
+{
+    const char *end = reader->end;
+
+    const char *name = p + 2;
+    const char *nameEnd = LMMarkupReaderReadName(name, end);
+
+    if (nameEnd == NULL) {
+        return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, name);
+    }
+
+    size_t length = nameEnd - name;
+
+    if (reader->depth == 0) {
+        return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, p);
+    }
+
+    LMMarkupSlice element = reader->elements[reader->depth - 1];
+
+    if (element.length != length || memcmp(element.bytes, name, length) != 0) {
+        return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, name);
+    }
+
+    p = LMMarkupReaderSkipSpace(nameEnd, end);
+
+    if (p == end || *p != '>') {
+        return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, p);
+    }
+
+    reader->depth--;
+
+    reader->name = element;
+
+    reader->position = p + 1;
+
+    return LMMarkupReaderToken(reader, LMMarkupTokenEndElement, p);
+}
+
+static LMMarkupTokenType LMMarkupReaderReadInstruction(LMMarkupReaderRef reader, const char *p, bool *declaration)
+{
+    const char *end = reader->end;
+
+    const char *start = p;
+
+    const char *target = p + 2;
+    const char *targetEnd = LMMarkupReaderReadName(target, end);
+
+    if (targetEnd == NULL) {
+        return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, target);
+    }
+
+    size_t length = targetEnd - target;
+
+    *declaration = (length == 3
+        && (target[0] == 'x' || target[0] == 'X')
+        && (target[1] == 'm' || target[1] == 'M')
+        && (target[2] == 'l' || target[2] == 'L'));
+
+    // The XML declaration may only appear at the start of the document
+    if (*declaration && start != reader->start) {
+        return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, target);
+    }
+
+    reader->name = (LMMarkupSlice){target, length};
+
+    const char *data = LMMarkupReaderSkipSpace(targetEnd, end);
+
+    if (data == targetEnd && !LMMarkupReaderHasPrefix(data, end, "?>")) {
+        return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, data);
+    }
+
+    const char *dataEnd = data;
+
+    for (;;) {
+        dataEnd = memchr(dataEnd, '?', end - dataEnd);
+
+        if (dataEnd == NULL) {
+            return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, end);
+        }
+
+        if (dataEnd + 1 < end && dataEnd[1] == '>') {
+            break;
+        }
+
+        dataEnd++;
+    }
+
+    if (memchr(data, '\r', dataEnd - data) != NULL) {
+        // Normalize line breaks in the instruction data
+        size_t offset = reader->bufferLength;
+
+        for (const char *c = data; c < dataEnd; c++) {
+            if (*c == '\r') {
+                if (c + 1 < dataEnd && c[1] == '\n') {
+                    continue;
+                }
+
+                if (!LMMarkupReaderAppend(reader, "\n", 1)) {
+                    return LMMarkupReaderFail(reader, LMMarkupErrorMemory, c);
+                }
+            } else if (!LMMarkupReaderAppend(reader, c, 1)) {
+                return LMMarkupReaderFail(reader, LMMarkupErrorMemory, c);
+            }
+        }
+
+        reader->data = (LMMarkupSlice){reader->buffer + offset, reader->bufferLength - offset};
+    } else {
+        reader->data = (LMMarkupSlice){data, dataEnd - data};
+    }
+
+    reader->position = dataEnd + 2;
+
+    return LMMarkupReaderToken(reader, LMMarkupTokenInstruction, dataEnd + 1);
+}
+
+static const char *LMMarkupReaderSkipComment(LMMarkupReaderRef reader, const char *p, const char **failure)
+{
+    const char *end = reader->end;
+
+    p += 4;
+
+    for (;;) {
+        const char *hyphen = memchr(p, '-', end - p);
+
+        if (hyphen == NULL) {
+            *failure = end;
+
+            return NULL;
+        }
+
+        if (hyphen + 1 < end && hyphen[1] == '-') {
+            // Double hyphens may only appear at the end of a comment
+            if (hyphen + 2 < end && hyphen[2] == '>') {
+                return hyphen + 3;
+            }
+
+            *failure = (hyphen + 2 < end) ? hyphen + 2 : end;
+
+            return NULL;
+        }
+
+        p = hyphen + 1;
+    }
+}
+
+static const char *LMMarkupReaderSkipDocumentType(LMMarkupReaderRef reader, const char *p, const char **failure)
+{
+    const char *end = reader->end;
+
+    uint32_t depth = 0;
+
+    for (p += 9; p < end; p++) {
+        if (*p == '[') {
+            depth++;
+        } else if (*p == ']' && depth > 0) {
+            depth--;
+        } else if (*p == '>' && depth == 0) {
+            return p + 1;
+        }
+    }
+
+    *failure = end;
+
+    return NULL;
+}
+
+LMMarkupReaderRef LMMarkupReaderCreate(const void *bytes, size_t length)
+{
+    LMMarkupReaderRef reader = calloc(1, sizeof(struct __LMMarkupReader));
+
+    if (reader == NULL) {
+        return NULL;
+    }
+
+    const char *start = bytes;
+
+    if (start == NULL) {
+        start = "";
+        length = 0;
+    }
+
+    // Skip the UTF-8 byte order mark, if present
+    if (length >= 3 && memcmp(start, "\xEF\xBB\xBF", 3) == 0) {
+        start += 3;
+        length -= 3;
+    }
+
+    reader->start = start;
+    reader->end = start + length;
+    reader->position = start;
+
+    reader->linePosition = start;
+    reader->lineStart = start;
+    reader->lineNumber = 1;
+
+    reader->name = (LMMarkupSlice){start, 0};
+    reader->data = (LMMarkupSlice){start, 0};
+
+    reader->line = 1;
+    reader->column = 1;
+
+    return reader;
+}
+
+void LMMarkupReaderRelease(LMMarkupReaderRef reader)
+{
+    if (reader == NULL) {
+        return;
+    }
+
+    free(reader->attributes);
+    free(reader->valueOffsets);
+    free(reader->buffer);
+    free(reader->elements);
+
+    free(reader);
+}
+
+LMMarkupTokenType LMMarkupReaderNext(LMMarkupReaderRef reader)
+{
+    if (reader->error != LMMarkupErrorNone) {
+        return LMMarkupTokenError;
+    }
+
+    reader->attributeCount = 0;
+    reader->bufferLength = 0;
+
+    reader->data = (LMMarkupSlice){reader->start, 0};
+
+    if (!reader->validated) {
+        // The input is validated once, so names and values can be returned without decoding them
+        reader->validated = true;
+
+        const char *invalid = LMMarkupReaderFindInvalidCharacter(reader->start, reader->end);
+
+        if (invalid != NULL) {
+            return LMMarkupReaderFail(reader, LMMarkupErrorEncoding, invalid);
+        }
+    }
+
+    if (reader->closeElement) {
+        reader->closeElement = false;
+
+        reader->name = reader->elements[--reader->depth];
+
+        return LMMarkupTokenEndElement;
+    }
+
+    const char *end = reader->end;
+
+    for (;;) {
+        const char *p = LMMarkupReaderSkipSpace(reader->position, end);
+
+        reader->position = p;
+
+        if (p == end) {
+            if (!reader->root || reader->depth > 0) {
+                return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, p);
+            }
+
+            reader->name = (LMMarkupSlice){reader->start, 0};
+
+            return LMMarkupReaderToken(reader, LMMarkupTokenEndOfDocument, p);
+        }
+
+        if (*p != '<') {
+            return LMMarkupReaderFail(reader, (reader->depth > 0) ? LMMarkupErrorCharacters : LMMarkupErrorSyntax, p);
+        }
+
+        if (p + 1 == end) {
+            return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, end);
+        }
+
+        switch (p[1]) {
+            case '?': {
+                bool declaration;
+                LMMarkupTokenType type = LMMarkupReaderReadInstruction(reader, p, &declaration);
+
+                if (type == LMMarkupTokenInstruction && declaration) {
+                    continue;
+                }
+
+                return type;
+            }
+
+            case '/': {
+                return LMMarkupReaderReadEndElement(reader, p);
+            }
+
+            case '!': {
+                const char *failure = p;
+                const char *next = NULL;
+
+                if (LMMarkupReaderHasPrefix(p, end, "<!--")) {
+                    next = LMMarkupReaderSkipComment(reader, p, &failure);
+                } else if (LMMarkupReaderHasPrefix(p, end, "<![CDATA[")) {
+                    return LMMarkupReaderFail(reader, (reader->depth > 0) ? LMMarkupErrorCDATA : LMMarkupErrorSyntax, p);
+                } else if (LMMarkupReaderHasPrefix(p, end, "<!DOCTYPE") && !reader->root) {
+                    next = LMMarkupReaderSkipDocumentType(reader, p, &failure);
+                }
+
+                if (next == NULL) {
+                    return LMMarkupReaderFail(reader, LMMarkupErrorSyntax, failure);
+                }
+
+                reader->position = next;
+
+                continue;
+            }
+
+            default: {
+                return LMMarkupReaderReadStartElement(reader, p);
+            }
+        }
+    }
+}
+
+LMMarkupSlice LMMarkupReaderGetName(LMMarkupReaderRef reader)
+{
+    return reader->name;
+}
+
+LMMarkupSlice LMMarkupReaderGetData(LMMarkupReaderRef reader)
+{
+    return reader->data;
+}
+
+uint32_t LMMarkupReaderGetAttributeCount(LMMarkupReaderRef reader)
+{
+    return reader->attributeCount;
+}
+
+const LMMarkupReaderAttribute *LMMarkupReaderGetAttribute(LMMarkupReaderRef reader, uint32_t index)
+{
+    return &reader->attributes[index];
+}
+
+uint32_t LMMarkupReaderGetLine(LMMarkupReaderRef reader)
+{
+    return reader->line;
+}
+
+uint32_t LMMarkupReaderGetColumn(LMMarkupReaderRef reader)
+{
+    return reader->column;
+}
+
+LMMarkupError LMMarkupReaderGetError(LMMarkupReaderRef reader)
+{
+    return reader->error;
+}
@@ -0,0 +1,144 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef LMMarkupReader_h
+#define LMMarkupReader_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Markup token types.
+ */
+typedef enum {
+    LMMarkupTokenEndOfDocument = 0,
+    LMMarkupTokenStartElement = 1,
+    LMMarkupTokenEndElement = 2,
+    LMMarkupTokenInstruction = 3,
+    LMMarkupTokenError = 4
+} LMMarkupTokenType;
+
+/**
+ * Markup reader errors.
+ */
+typedef enum {
+    LMMarkupErrorNone = 0,
+    LMMarkupErrorSyntax = 1,
+    LMMarkupErrorCharacters = 2,
+    LMMarkupErrorCDATA = 3,
+    LMMarkupErrorMemory = 4,
+    LMMarkupErrorEncoding = 5
+} LMMarkupError;
+
+/**
+ * Slice of UTF-8 text. Slices are not null-terminated.
+ */
+typedef struct {
+    const char *bytes;
+    size_t length;
+} LMMarkupSlice;
+
+/**
+ * Element attribute.
+ */
+typedef struct {
+    LMMarkupSlice key;
+    LMMarkupSlice value;
+} LMMarkupReaderAttribute;
+
+/**
+ * Markup reader. A reader tokenizes the subset of XML used by markup documents
+ * (elements, attributes, processing instructions, and comments) directly from a
+ * UTF-8 buffer. The buffer must contain only well-formed UTF-8 encoding characters that
+ * are permitted by XML; otherwise, the first call to <code>LMMarkupReaderNext</code> reports
+ * <code>LMMarkupErrorEncoding</code> at the position of the first invalid byte. Names and
+ * values are returned as slices that borrow from the buffer
+ * wherever possible; values containing entity or character references are decoded
+ * into storage owned by the reader. Slices remain valid until the next token is read.
+ */
+typedef struct __LMMarkupReader *LMMarkupReaderRef;
+
+/**
+ * Creates a reader. The buffer is not copied, and must remain valid for the lifetime
+ * of the reader.
+ *
+ * @param bytes The markup to read.
+ * @param length The length of the markup in bytes.
+ *
+ * @return The new reader, or <code>NULL</code> if the reader could not be allocated.
+ */
+LMMarkupReaderRef LMMarkupReaderCreate(const void *bytes, size_t length);
+
+/**
+ * Releases a reader.
+ *
+ * @param reader The reader to release.
+ */
+void LMMarkupReaderRelease(LMMarkupReaderRef reader);
+
+/**
+ * Reads the next token. Once an error has been reported, all subsequent calls
+ * return <code>LMMarkupTokenError</code>.
+ *
+ * @param reader The reader.
+ *
+ * @return The type of the token.
+ */
+LMMarkupTokenType LMMarkupReaderNext(LMMarkupReaderRef reader);
+
+/**
+ * Returns the name of the current element, or the target of the current processing instruction.
+ */
+LMMarkupSlice LMMarkupReaderGetName(LMMarkupReaderRef reader);
+
+/**
+ * Returns the data of the current processing instruction.
+ */
+LMMarkupSlice LMMarkupReaderGetData(LMMarkupReaderRef reader);
+
+/**
+ * Returns the number of attributes of the current start element.
+ */
+uint32_t LMMarkupReaderGetAttributeCount(LMMarkupReaderRef reader);
+
+/**
+ * Returns an attribute of the current start element.
+ */
+const LMMarkupReaderAttribute *LMMarkupReaderGetAttribute(LMMarkupReaderRef reader, uint32_t index);
+
+/**
+ * Returns the line number at which the current token ends or the error occurred.
+ */
+uint32_t LMMarkupReaderGetLine(LMMarkupReaderRef reader);
+
+/**
+ * Returns the column number at which the error occurred.
+ */
+uint32_t LMMarkupReaderGetColumn(LMMarkupReaderRef reader);
+
+/**
+ * Returns the error that was encountered, if any.
+ */
+LMMarkupError LMMarkupReaderGetError(LMMarkupReaderRef reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,192 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "LMMarkupValue.h"
+
+#include <math.h>
+#include <string.h>
+
+static const char *kTextStyles[] = {
+    "title1",
+    "title2",
+    "title3",
+    "headline",
+    "subheadline",
+    "body",
+    "callout",
+    "footnote",
+    "caption1",
+    "caption2"
+};
+
+static int LMMarkupHexDigit(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    } else {
+        return -1;
+    }
+}
+
+bool LMMarkupParseColor(const char *bytes, size_t length, uint8_t components[4])
+{
+    if (length == 0 || bytes[0] != '#') {
+        return false;
+    }
+
+    bytes++;
+    length--;
+
+    components[3] = 0xFF;
+
+    if (length == 3) {
+        // Each digit is repeated, so "#f80" is equivalent to "#ff8800"
+        for (size_t i = 0; i < 3; i++) {
+            int digit = LMMarkupHexDigit(bytes[i]);
+
+            if (digit < 0) {
+                return false;
+            }
+
+            components[i] = (uint8_t)(digit * 17);
+        }
+    } else if (length == 6 || length == 8) {
+        for (size_t i = 0; i < length / 2; i++) {
+            int high = LMMarkupHexDigit(bytes[i * 2]);
+            int low = LMMarkupHexDigit(bytes[i * 2 + 1]);
+
+            if (high < 0 || low < 0) {
+                return false;
+            }
+
+            components[i] = (uint8_t)((high << 4) | low);
+        }
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+static bool LMMarkupIsEqual(const char *bytes, size_t length, const char *string)
+{
+    return strlen(string) == length && memcmp(bytes, string, length) == 0;
+}
+
+static double LMMarkupParseSize(const char *bytes, size_t length)
+{
+    // Parses a leading decimal value, ignoring any trailing characters; values without
+    // a leading number are 0, as with -[NSString floatValue]
+    size_t i = 0;
+
+    while (i < length && (bytes[i] == ' ' || bytes[i] == '\t')) {
+        i++;
+    }
+
+    double sign = 1;
+
+    if (i < length && (bytes[i] == '-' || bytes[i] == '+')) {
+        sign = (bytes[i] == '-') ? -1 : 1;
+
+        i++;
+    }
+
+    double value = 0;
+
+    while (i < length && bytes[i] >= '0' && bytes[i] <= '9') {
+        value = value * 10 + (bytes[i++] - '0');
+    }
+
+    if (i < length && bytes[i] == '.') {
+        double scale = 0.1;
+
+        for (i++; i < length && bytes[i] >= '0' && bytes[i] <= '9'; i++) {
+            value += (bytes[i] - '0') * scale;
+            scale /= 10;
+        }
+    }
+
+    if (i + 1 < length && (bytes[i] == 'e' || bytes[i] == 'E')) {
+        size_t j = i + 1;
+
+        int exponentSign = 1;
+
+        if (bytes[j] == '-' || bytes[j] == '+') {
+            exponentSign = (bytes[j] == '-') ? -1 : 1;
+
+            j++;
+        }
+
+        if (j < length && bytes[j] >= '0' && bytes[j] <= '9') {
+            int exponent = 0;
+
+            for (; j < length && bytes[j] >= '0' && bytes[j] <= '9'; j++) {
+                if (exponent < 1000) {
+                    exponent = exponent * 10 + (bytes[j] - '0');
+                }
+            }
+
+            value *= pow(10, exponentSign * exponent);
+        }
+    }
+
+    return sign * value;
+}
+
+bool LMMarkupParseFont(const char *bytes, size_t length, LMMarkupFont *font)
+{
+    for (size_t i = 0; i < sizeof(kTextStyles) / sizeof(kTextStyles[0]); i++) {
+        if (LMMarkupIsEqual(bytes, length, kTextStyles[i])) {
+            font->type = LMMarkupFontTextStyle;
+            font->textStyle = (LMMarkupTextStyle)i;
+            font->nameLength = 0;
+            font->size = 0;
+
+            return true;
+        }
+    }
+
+    // Other values must consist of exactly two space-separated components
+    const char *space = memchr(bytes, ' ', length);
+
+    if (space == NULL) {
+        return false;
+    }
+
+    size_t nameLength = space - bytes;
+
+    if (memchr(space + 1, ' ', length - nameLength - 1) != NULL) {
+        return false;
+    }
+
+    if (LMMarkupIsEqual(bytes, nameLength, "System")) {
+        font->type = LMMarkupFontSystem;
+    } else if (LMMarkupIsEqual(bytes, nameLength, "System-Bold")) {
+        font->type = LMMarkupFontBoldSystem;
+    } else if (LMMarkupIsEqual(bytes, nameLength, "System-Italic")) {
+        font->type = LMMarkupFontItalicSystem;
+    } else {
+        font->type = LMMarkupFontNamed;
+    }
+
+    font->textStyle = LMMarkupTextStyleBody;
+    font->nameLength = nameLength;
+    font->size = LMMarkupParseSize(space + 1, length - nameLength - 1);
+
+    return true;
+}
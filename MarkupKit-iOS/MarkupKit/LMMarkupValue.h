@@ -0,0 +1,94 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef LMMarkupValue_h
+#define LMMarkupValue_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Parses a hexadecimal color value. Supported forms are "#RGB", "#RRGGBB", and
+ * "#RRGGBBAA"; colors without an alpha component are opaque.
+ *
+ * @param bytes The color value's characters.
+ * @param length The number of characters.
+ * @param components On return, the red, green, blue, and alpha components.
+ *
+ * @return <code>true</code> if the value is a valid color; <code>false</code>, otherwise.
+ */
+bool LMMarkupParseColor(const char *bytes, size_t length, uint8_t components[4]);
+
+/**
+ * Font types.
+ */
+typedef enum {
+    LMMarkupFontTextStyle = 1,
+    LMMarkupFontSystem = 2,
+    LMMarkupFontBoldSystem = 3,
+    LMMarkupFontItalicSystem = 4,
+    LMMarkupFontNamed = 5
+} LMMarkupFontType;
+
+/**
+ * Text styles.
+ */
+typedef enum {
+    LMMarkupTextStyleTitle1 = 0,
+    LMMarkupTextStyleTitle2,
+    LMMarkupTextStyleTitle3,
+    LMMarkupTextStyleHeadline,
+    LMMarkupTextStyleSubheadline,
+    LMMarkupTextStyleBody,
+    LMMarkupTextStyleCallout,
+    LMMarkupTextStyleFootnote,
+    LMMarkupTextStyleCaption1,
+    LMMarkupTextStyleCaption2
+} LMMarkupTextStyle;
+
+/**
+ * Font specification. Named fonts refer to the leading <code>nameLength</code>
+ * characters of the parsed value.
+ */
+typedef struct {
+    LMMarkupFontType type;
+    LMMarkupTextStyle textStyle;
+    size_t nameLength;
+    double size;
+} LMMarkupFont;
+
+/**
+ * Parses a font value. A font value is either the name of a text style, such as
+ * "body" or "title1", or a font name and size separated by a single space, such
+ * as "Helvetica 24". The names "System", "System-Bold", and "System-Italic" refer
+ * to the system font.
+ *
+ * @param bytes The font value's UTF-8 bytes.
+ * @param length The length of the font value in bytes.
+ * @param font On return, the font specification.
+ *
+ * @return <code>true</code> if the value is a valid font specification; <code>false</code>, otherwise.
+ */
+bool LMMarkupParseFont(const char *bytes, size_t length, LMMarkupFont *font);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -14,6 +14,7 @@
 
 #import "LMPageView.h"
 #import "UIKit+Markup.h"
+#import "LMBinding.h"
 
 @implementation LMPageView
 {
@@ -22,6 +23,8 @@
     NSArray *_constraints;
 
     NSInteger _currentPage;
+
+    NSHashTable *_visiblePages;
 }
 
 + (BOOL)requiresConstraintBasedLayout
@@ -36,6 +39,8 @@
     if (self) {
         _pages = [NSMutableArray new];
 
+        _visiblePages = [NSHashTable weakObjectsHashTable];
+
         [self setPagingEnabled:YES];
 
         [self setShowsHorizontalScrollIndicator:NO];
@@ -132,6 +137,21 @@
     }
 
     [super layoutSubviews];
+
+    // Resume bindings that were suspended while their pages were scrolled out of view
+    CGRect bounds = [self bounds];
+
+    for (UIView *page in _pages) {
+        if (CGRectIntersectsRect([page frame], bounds)) {
+            if (![_visiblePages containsObject:page]) {
+                [_visiblePages addObject:page];
+
+                [LMBindingHub resumeBindingsInView:page];
+            }
+        } else {
+            [_visiblePages removeObject:page];
+        }
+    }
 }
 
 - (void)setNeedsUpdateConstraints
@@ -0,0 +1,79 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "LMEnumTable.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Converts a markup property value. Functions that apply the value themselves
+ * return <code>nil</code>.
+ */
+typedef id _Nullable (*LMPropertyConverterFunction)(id object, id _Nullable value);
+
+/**
+ * Property converter. A converter either maps names to values using an enumeration
+ * table or calls a conversion function.
+ */
+typedef struct {
+    const char *key;
+    LMEnumTable * _Nullable values;
+    LMPropertyConverterFunction _Nullable function;
+} LMPropertyConverter;
+
+/**
+ * Returns the number of converters in a static array.
+ */
+#define LMPropertyConverterCount(converters) (sizeof(converters) / sizeof((converters)[0]))
+
+/**
+ * Finds a converter in a static array.
+ *
+ * @param converters The converters to search.
+ * @param count The number of converters.
+ * @param key The property's key.
+ *
+ * @return The converter for the key, or <code>NULL</code> if the array does not contain one.
+ */
+static inline const LMPropertyConverter * _Nullable LMFindPropertyConverter(const LMPropertyConverter *converters, size_t count, NSString *key)
+{
+    const char *name = [key UTF8String];
+
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(converters[i].key, name) == 0) {
+            return &converters[i];
+        }
+    }
+
+    return NULL;
+}
+
+@interface NSObject (LMPropertyConverter)
+
+/**
+ * Returns the converter for a markup property. Categories that convert property
+ * values override this method and call the superclass implementation for keys
+ * they do not handle. The result is resolved once per class and key.
+ *
+ * @param key The property's key.
+ *
+ * @return The converter, or <code>NULL</code> if values are applied as is.
+ */
++ (nullable const LMPropertyConverter *)propertyConverterForKey:(NSString *)key;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -32,6 +32,55 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (nullable UIView *)viewWithName:(NSString *)name owner:(nullable id)owner root:(nullable UIView *)root;
 
+/**
+ * Compiles a markup document. When a compiled document (a resource with the same
+ * name as the markup document and an extension of ".mkb") is present in the view's
+ * bundle, it is loaded in place of the markup.
+ *
+ * @param url The URL of the markup document to compile.
+ *
+ * @return The compiled document. An exception is raised if the markup document
+ * cannot be read or parsed.
+ */
++ (NSData *)compiledDocumentAtURL:(NSURL *)url;
+
+/**
+ * Returns the maximum number of bytes occupied by cached documents. Parsed documents
+ * are cached by bundle and view name, and the least recently used documents are
+ * evicted when the limit is exceeded.
+ *
+ * @return The document cache limit, in bytes.
+ */
++ (NSUInteger)documentCacheLimit;
+
+/**
+ * Sets the maximum number of bytes occupied by cached documents. A limit of 0
+ * disables caching.
+ *
+ * @param limit The document cache limit, in bytes.
+ */
++ (void)setDocumentCacheLimit:(NSUInteger)limit;
+
+/**
+ * Returns the number of document loads that were served from the cache.
+ *
+ * @return The document cache hit count.
+ */
++ (NSUInteger)documentCacheHitCount;
+
+/**
+ * Returns the number of document loads that required the document to be read from its bundle.
+ *
+ * @return The document cache miss count.
+ */
++ (NSUInteger)documentCacheMissCount;
+
+/**
+ * Removes all documents from the cache. The cache is also purged automatically when
+ * the application receives a memory warning.
+ */
++ (void)purgeDocumentCache;
+
 /**
  * Decodes a color value.
  *
@@ -16,7 +16,81 @@
 #import "Foundation+Markup.h"
 #import "UIKit+Markup.h"
 
-@interface LMViewBuilder () <NSXMLParserDelegate>
+#import "LMMarkupCompiler.h"
+#import "LMMarkupValue.h"
+#import "LMBinding.h"
+
+#import <os/lock.h>
+
+typedef enum {
+    LMAttributeProperty = 0,
+    LMAttributeFactory,
+    LMAttributeTemplate,
+    LMAttributeOutlet,
+    LMAttributeAction
+} LMAttributeType;
+
+typedef enum {
+    LMValueDefault = 0,
+    LMValueColor,
+    LMValueFont,
+    LMValueImage
+} LMValueType;
+
+typedef enum {
+    LMAttributeValuePlain = 0,
+    LMAttributeValueBinding,
+    LMAttributeValueLocalizedString,
+    LMAttributeValueEscaped
+} LMAttributeValueType;
+
+@interface LMTemplate : NSObject
+
+@property (nonatomic, readonly) NSDictionary *properties;
+
+@property (nonatomic, readonly) NSUInteger count;
+
+- (instancetype)initWithProperties:(NSDictionary *)properties;
+
+- (NSString *)keyPathAtIndex:(NSUInteger)index;
+- (id)valueAtIndex:(NSUInteger)index;
+- (BOOL)isDeferredAtIndex:(NSUInteger)index;
+
+@end
+
+@interface LMTemplateRegistry : NSObject
+
+- (instancetype)initWithTemplates:(NSDictionary<NSString *, LMTemplate *> *)templates;
+
+- (LMTemplateRegistry *)registryByMergingTemplates:(NSDictionary<NSString *, NSDictionary *> *)templates;
+
+- (LMTemplate *)templateForName:(NSString *)name;
+- (LMTemplate *)templateForClasses:(NSString *)classes;
+
+@end
+
+@interface LMViewDocument : NSObject
+
+@property (nonatomic, readonly) LMMarkupDocumentRef markupDocument;
+@property (nonatomic, readonly) NSArray<NSString *> *strings;
+
+@property (nonatomic, readonly) NSUInteger size;
+
+- (instancetype)initWithMarkupDocument:(LMMarkupDocumentRef)markupDocument;
+
+- (NSDictionary<NSString *, NSDictionary *> *)templatesForNode:(uint32_t)index;
+- (LMTemplateRegistry *)templateRegistryForNode:(uint32_t)index;
+
+- (LMAttributeType)typeOfKey:(uint32_t)index;
+- (UIControlEvents)eventForKey:(uint32_t)index;
+- (LMAttributeValueType)typeOfValue:(uint32_t)index;
+
+@end
+
+@interface LMMarkupParser : NSObject
+
++ (LMMarkupDocumentRef)documentWithContentsOfURL:(NSURL *)url;
++ (LMMarkupDocumentRef)documentWithData:(NSData *)data;
 
 @end
 
@@ -25,13 +99,60 @@
     id _owner;
     UIView *_root;
 
-    NSMutableDictionary *_templates;
+    LMTemplateRegistry *_templates;
+    BOOL _templatesModified;
+
     NSMutableArray *_views;
 
     NSString *_target;
+
+    NSMutableDictionary<NSString *, id> *_colors;
+    NSMutableDictionary<NSString *, id> *_fonts;
+    NSMutableDictionary<NSString *, id> *_images;
+
+    NSBundle *_stringBundle;
+    NSString *_stringTable;
+    NSDictionary<NSString *, NSString *> *_strings;
 }
 
-static NSMutableDictionary *colorTable;
+static NSDictionary<NSString *, UIColor *> *colorTable;
+
+static NSMutableDictionary<NSString *, UIColor *> *hexColors;
+static os_unfair_lock hexColorsLock = OS_UNFAIR_LOCK_INIT;
+
+static NSMutableDictionary<NSString *, id> *namedColors;
+static os_unfair_lock namedColorsLock = OS_UNFAIR_LOCK_INIT;
+
+static NSArray<UIFontTextStyle> *textStyles;
+
+static NSMutableDictionary<NSString *, id> *fonts;
+static os_unfair_lock fontsLock = OS_UNFAIR_LOCK_INIT;
+
+static NSMutableDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *stringTables;
+static os_unfair_lock stringTablesLock = OS_UNFAIR_LOCK_INIT;
+
+static NSDictionary<NSString *, NSNumber *> *attributeTypes;
+static NSDictionary<NSString *, NSNumber *> *attributeEvents;
+
+static NSMutableDictionary<NSString *, NSNumber *> *keyPathTypes;
+static os_unfair_lock keyPathTypesLock = OS_UNFAIR_LOCK_INIT;
+
+static NSMutableDictionary<NSString *, LMViewDocument *> *documentCache;
+static NSMutableOrderedSet<NSString *> *documentCacheKeys;
+
+static NSUInteger documentCacheSize;
+static NSUInteger documentCacheLimit = 2 * 1024 * 1024;
+
+static NSUInteger documentCacheHitCount;
+static NSUInteger documentCacheMissCount;
+
+static os_unfair_lock documentCacheLock = OS_UNFAIR_LOCK_INIT;
+
+static NSString * const kStringTableExtension = @"strings";
+static NSString * const kDefaultStringTable = @"Localizable";
+
+static NSString * const kDocumentExtension = @"xml";
+static NSString * const kCompiledDocumentExtension = @"mkb";
 
 static NSString * const kCaseTarget = @"case";
 static NSString * const kEndTarget = @"end";
@@ -49,24 +170,81 @@ static NSString * const kEscapePrefix = @"^";
 
 + (void)initialize
 {
-    colorTable = [NSMutableDictionary new];
-
-    NSString *colorTablePath = [[NSBundle mainBundle] pathForResource:@"Colors" ofType:@"plist"];
-
-    if (colorTablePath != nil) {
-        NSError *error = nil;
-
-        NSDictionary *colorTableValues = [NSPropertyListSerialization propertyListWithData:[NSData dataWithContentsOfFile:colorTablePath]
-            options:0 format:nil error:&error];
-
-        if (error != nil) {
-            [NSException raise:NSGenericException format:@"%@: %@", colorTablePath, [error description]];
-        }
-
-        for (NSString *key in colorTableValues) {
-            [colorTable setObject:[LMViewBuilder colorValue:[colorTableValues objectForKey:key]] forKey:key];
-        }
-    }
+    keyPathTypes = [NSMutableDictionary new];
+
+    attributeTypes = @{
+        kFactoryKey: @(LMAttributeFactory),
+        kTemplateKey: @(LMAttributeTemplate),
+        kOutletKey: @(LMAttributeOutlet)
+    };
+
+    attributeEvents = @{
+        @"onTouchDown": @(UIControlEventTouchDown),
+        @"onTouchDownRepeat": @(UIControlEventTouchDownRepeat),
+        @"onTouchDragInside": @(UIControlEventTouchDragInside),
+        @"onTouchDragOutside": @(UIControlEventTouchDragOutside),
+        @"onTouchDragEnter": @(UIControlEventTouchDragEnter),
+        @"onTouchDragExit": @(UIControlEventTouchDragExit),
+        @"onTouchUpInside": @(UIControlEventTouchUpInside),
+        @"onTouchUpOutside": @(UIControlEventTouchUpOutside),
+        @"onTouchCancel": @(UIControlEventTouchCancel),
+        @"onValueChanged": @(UIControlEventValueChanged),
+        @"onPrimaryActionTriggered": @(UIControlEventPrimaryActionTriggered),
+        @"onEditingDidBegin": @(UIControlEventEditingDidBegin),
+        @"onEditingChanged": @(UIControlEventEditingChanged),
+        @"onEditingDidEnd": @(UIControlEventEditingDidEnd),
+        @"onEditingDidEndOnExit": @(UIControlEventEditingDidEndOnExit),
+        @"onAllTouchEvents": @(UIControlEventAllTouchEvents),
+        @"onAllEditingEvents": @(UIControlEventAllEditingEvents),
+        @"onAllEvents": @(UIControlEventAllEvents)
+    };
+
+    documentCache = [NSMutableDictionary new];
+    documentCacheKeys = [NSMutableOrderedSet new];
+
+    [[NSNotificationCenter defaultCenter] addObserverForName:UIApplicationDidReceiveMemoryWarningNotification object:nil
+        queue:nil usingBlock:^(NSNotification *notification) {
+        [LMViewBuilder purgeDocumentCache];
+    }];
+
+    hexColors = [NSMutableDictionary new];
+    namedColors = [NSMutableDictionary new];
+
+    // Indexed by LMMarkupTextStyle
+    textStyles = @[
+        UIFontTextStyleTitle1,
+        UIFontTextStyleTitle2,
+        UIFontTextStyleTitle3,
+        UIFontTextStyleHeadline,
+        UIFontTextStyleSubheadline,
+        UIFontTextStyleBody,
+        UIFontTextStyleCallout,
+        UIFontTextStyleFootnote,
+        UIFontTextStyleCaption1,
+        UIFontTextStyleCaption2
+    ];
+
+    fonts = [NSMutableDictionary new];
+
+    [[NSNotificationCenter defaultCenter] addObserverForName:UIContentSizeCategoryDidChangeNotification object:nil
+        queue:nil usingBlock:^(NSNotification *notification) {
+        os_unfair_lock_lock(&fontsLock);
+
+        [fonts removeAllObjects];
+
+        os_unfair_lock_unlock(&fontsLock);
+    }];
+
+    stringTables = [NSMutableDictionary new];
+
+    [[NSNotificationCenter defaultCenter] addObserverForName:NSCurrentLocaleDidChangeNotification object:nil
+        queue:nil usingBlock:^(NSNotification *notification) {
+        os_unfair_lock_lock(&stringTablesLock);
+
+        [stringTables removeAllObjects];
+
+        os_unfair_lock_unlock(&stringTablesLock);
+    }];
 }
 
 + (UIView *)viewWithName:(NSString *)name owner:(id)owner root:(UIView *)root
@@ -79,15 +257,20 @@ static NSString * const kEscapePrefix = @"^";
         bundle = [NSBundle mainBundle];
     }
 
-    NSURL *url = [bundle URLForResource:name withExtension:@"xml"];
+    LMViewDocument *document = [LMViewBuilder documentWithName:name bundle:bundle];
 
-    if (url != nil) {
+    if (document != nil) {
         LMViewBuilder *viewBuilder = [[LMViewBuilder alloc] initWithOwner:owner root:root];
 
-        NSXMLParser *parser = [[NSXMLParser alloc] initWithContentsOfURL:url];
+        // Initial values for coalescing bindings are applied once the document has been built
+        [LMBindingHub beginDeferringUpdates];
 
-        [parser setDelegate:viewBuilder];
-        [parser parse];
+        @try {
+            [viewBuilder build:document];
+        }
+        @finally {
+            [LMBindingHub endDeferringUpdates];
+        }
 
         view = [viewBuilder root];
     }
@@ -95,396 +278,1418 @@ static NSString * const kEscapePrefix = @"^";
     return view;
 }
 
-+ (UIColor *)colorValue:(NSString *)value
++ (LMViewDocument *)documentWithName:(NSString *)name bundle:(NSBundle *)bundle
 {
-    UIColor *color = nil;
+    NSString *key = [NSString stringWithFormat:@"%@/%@", [bundle bundlePath], name];
 
-    if ([value hasPrefix:@"#"]) {
-        if ([value length] < 9) {
-            value = [NSString stringWithFormat:@"%@ff", value];
-        }
+    os_unfair_lock_lock(&documentCacheLock);
 
-        if ([value length] == 9) {
-            int red, green, blue, alpha;
-            sscanf([value UTF8String], "#%02X%02X%02X%02X", &red, &green, &blue, &alpha);
+    LMViewDocument *document = [documentCache objectForKey:key];
 
-            color = [UIColor colorWithRed:red / 255.0 green:green / 255.0 blue:blue / 255.0 alpha:alpha / 255.0];
-        }
-    } else {
-        UIImage *image = [UIImage imageNamed:value];
+    if (document != nil) {
+        documentCacheHitCount++;
 
-        if (image != nil) {
-            color = [UIColor colorWithPatternImage:image];
-        } else {
-            if (@available(iOS 11, tvOS 11, *)) {
-                color = [UIColor colorNamed:value];
-            }
+        // Move to most recently used position
+        [documentCacheKeys removeObject:key];
+        [documentCacheKeys addObject:key];
+    } else {
+        documentCacheMissCount++;
+    }
 
-            if (color == nil) {
-                color = [colorTable objectForKey:value];
+    os_unfair_lock_unlock(&documentCacheLock);
 
-                if (color == nil) {
-                    NSString *selectorName = [NSString stringWithFormat:@"%@Color", value];
+    if (document == nil) {
+        document = [LMViewBuilder loadDocumentWithName:name bundle:bundle];
 
-                    if ([[UIColor self] respondsToSelector:NSSelectorFromString(selectorName)]) {
-                        color = [[UIColor self] valueForKey:selectorName];
-                    }
-                }
-            }
+        if (document != nil) {
+            [LMViewBuilder cacheDocument:document forKey:key];
         }
     }
 
-    return color;
+    return document;
 }
 
-+ (UIFont *)fontValue:(NSString *)value
++ (void)cacheDocument:(LMViewDocument *)document forKey:(NSString *)key
 {
-    UIFont *font = nil;
+    os_unfair_lock_lock(&documentCacheLock);
 
-    if ([value isEqual:@"title1"]) {
-        font = [UIFont preferredFontForTextStyle:UIFontTextStyleTitle1];
-    } else if ([value isEqual:@"title2"]) {
-        font = [UIFont preferredFontForTextStyle:UIFontTextStyleTitle2];
-    } else if ([value isEqual:@"title3"]) {
-        font = [UIFont preferredFontForTextStyle:UIFontTextStyleTitle3];
-    } else if ([value isEqual:@"headline"]) {
-        font = [UIFont preferredFontForTextStyle:UIFontTextStyleHeadline];
-    } else if ([value isEqual:@"subheadline"]) {
-        font = [UIFont preferredFontForTextStyle:UIFontTextStyleSubheadline];
-    } else if ([value isEqual:@"body"]) {
-        font = [UIFont preferredFontForTextStyle:UIFontTextStyleBody];
-    } else if ([value isEqual:@"callout"]) {
-        font = [UIFont preferredFontForTextStyle:UIFontTextStyleCallout];
-    } else if ([value isEqual:@"footnote"]) {
-        font = [UIFont preferredFontForTextStyle:UIFontTextStyleFootnote];
-    } else if ([value isEqual:@"caption1"]) {
-        font = [UIFont preferredFontForTextStyle:UIFontTextStyleCaption1];
-    } else if ([value isEqual:@"caption2"]) {
-        font = [UIFont preferredFontForTextStyle:UIFontTextStyleCaption2];
-    } else {
-        NSArray *components = [value componentsSeparatedByString:@" "];
-
-        if ([components count] == 2) {
-            NSString *fontName = [components objectAtIndex:0];
-            CGFloat fontSize = [[components objectAtIndex:1] floatValue];
-
-            if ([fontName isEqual:@"System"]) {
-                font = [UIFont systemFontOfSize:fontSize];
-            } else if ([fontName isEqual:@"System-Bold"]) {
-                font = [UIFont boldSystemFontOfSize:fontSize];
-            } else if ([fontName isEqual:@"System-Italic"]) {
-                font = [UIFont italicSystemFontOfSize:fontSize];
-            } else {
-                font = [UIFont fontWithName:fontName size:fontSize];
-            }
-        }
+    LMViewDocument *previousDocument = [documentCache objectForKey:key];
+
+    if (previousDocument != nil) {
+        documentCacheSize -= [previousDocument size];
+
+        [documentCacheKeys removeObject:key];
     }
 
-    return font;
+    [documentCache setObject:document forKey:key];
+    [documentCacheKeys addObject:key];
+
+    documentCacheSize += [document size];
+
+    [LMViewBuilder trimDocumentCache];
+
+    os_unfair_lock_unlock(&documentCacheLock);
 }
 
-- (instancetype)initWithOwner:(id)owner root:(UIView *)root
++ (void)trimDocumentCache
 {
-    self = [super init];
-
-    if (self) {
-        _owner = owner;
-        _root = root;
+    // Evict least recently used documents until the cache fits its budget
+    while (documentCacheSize > documentCacheLimit && [documentCacheKeys count] > 0) {
+        NSString *key = [documentCacheKeys firstObject];
 
-        _templates = [NSMutableDictionary new];
-        _views = [NSMutableArray new];
+        documentCacheSize -= [[documentCache objectForKey:key] size];
 
-        _target = nil;
+        [documentCache removeObjectForKey:key];
+        [documentCacheKeys removeObjectAtIndex:0];
     }
-
-    return self;
 }
 
-- (UIView *)root
++ (NSUInteger)documentCacheLimit
 {
-    return _root;
+    os_unfair_lock_lock(&documentCacheLock);
+
+    NSUInteger limit = documentCacheLimit;
+
+    os_unfair_lock_unlock(&documentCacheLock);
+
+    return limit;
 }
 
-- (void)parser:(NSXMLParser *)parser didStartElement:(NSString *)elementName
-    namespaceURI:(NSString *)namespaceURI qualifiedName:(NSString *)qName
-    attributes:(NSDictionary *)attributes
++ (void)setDocumentCacheLimit:(NSUInteger)limit
 {
-    if (_target != nil && ![_target isEqual:[[UIDevice currentDevice] systemName]]) {
-        return;
-    }
-
-    NSBundle *bundle = [_owner bundleForStrings];
+    os_unfair_lock_lock(&documentCacheLock);
 
-    if (bundle == nil) {
-        bundle = [NSBundle mainBundle];
-    }
+    documentCacheLimit = limit;
 
-    NSString *table = [_owner tableForStrings];
+    [LMViewBuilder trimDocumentCache];
 
-    NSString *factory = nil;
-    NSString *template = nil;
-    NSString *outlet = nil;
-    NSMutableDictionary *actions = [NSMutableDictionary new];
-    NSMutableDictionary *bindings = [NSMutableDictionary new];
-    NSMutableDictionary *properties = [NSMutableDictionary new];
+    os_unfair_lock_unlock(&documentCacheLock);
+}
 
-    for (NSString *key in attributes) {
-        NSString *value = [attributes objectForKey:key];
-
-        if ([key isEqual:kFactoryKey]) {
-            factory = value;
-        } else if ([key isEqual:kTemplateKey]) {
-            template = value;
-        } else if ([key isEqual:kOutletKey]) {
-            outlet = value;
-        } else if ([key isEqual:@"onTouchDown"]) {
-            [actions setObject:value forKey:@(UIControlEventTouchDown)];
-        } else if ([key isEqual:@"onTouchDownRepeat"]) {
-            [actions setObject:value forKey:@(UIControlEventTouchDownRepeat)];
-        } else if ([key isEqual:@"onTouchDragInside"]) {
-            [actions setObject:value forKey:@(UIControlEventTouchDragInside)];
-        } else if ([key isEqual:@"onTouchDragOutside"]) {
-            [actions setObject:value forKey:@(UIControlEventTouchDragOutside)];
-        } else if ([key isEqual:@"onTouchDragEnter"]) {
-            [actions setObject:value forKey:@(UIControlEventTouchDragEnter)];
-        } else if ([key isEqual:@"onTouchDragExit"]) {
-            [actions setObject:value forKey:@(UIControlEventTouchDragExit)];
-        } else if ([key isEqual:@"onTouchUpInside"]) {
-            [actions setObject:value forKey:@(UIControlEventTouchUpInside)];
-        } else if ([key isEqual:@"onTouchUpOutside"]) {
-            [actions setObject:value forKey:@(UIControlEventTouchUpOutside)];
-        } else if ([key isEqual:@"onTouchCancel"]) {
-            [actions setObject:value forKey:@(UIControlEventTouchCancel)];
-        } else if ([key isEqual:@"onValueChanged"]) {
-            [actions setObject:value forKey:@(UIControlEventValueChanged)];
-        } else if ([key isEqual:@"onPrimaryActionTriggered"]) {
-            [actions setObject:value forKey:@(UIControlEventPrimaryActionTriggered)];
-        } else if ([key isEqual:@"onEditingDidBegin"]) {
-            [actions setObject:value forKey:@(UIControlEventEditingDidBegin)];
-        } else if ([key isEqual:@"onEditingChanged"]) {
-            [actions setObject:value forKey:@(UIControlEventEditingChanged)];
-        } else if ([key isEqual:@"onEditingDidEnd"]) {
-            [actions setObject:value forKey:@(UIControlEventEditingDidEnd)];
-        } else if ([key isEqual:@"onEditingDidEndOnExit"]) {
-            [actions setObject:value forKey:@(UIControlEventEditingDidEndOnExit)];
-        } else if ([key isEqual:@"onAllTouchEvents"]) {
-            [actions setObject:value forKey:@(UIControlEventAllTouchEvents)];
-        } else if ([key isEqual:@"onAllEditingEvents"]) {
-            [actions setObject:value forKey:@(UIControlEventAllEditingEvents)];
-        } else if ([key isEqual:@"onAllEvents"]) {
-            [actions setObject:value forKey:@(UIControlEventAllEvents)];
-        } else if ([value hasPrefix:kBindingPrefix]) {
-            [bindings setObject:[value substringFromIndex:[kBindingPrefix length]] forKey:key];
-        } else if ([value hasPrefix:kLocalizedStringPrefix]) {
-            [properties setObject:[bundle localizedStringForKey:[value substringFromIndex:[kLocalizedStringPrefix length]] value:value table:table] forKey:key];
-        } else if ([value hasPrefix:kEscapePrefix]) {
-            [properties setObject:[value substringFromIndex:[kEscapePrefix length]] forKey:key];
-        } else {
-            [properties setObject:value forKey:key];
-        }
-    }
++ (NSUInteger)documentCacheHitCount
+{
+    os_unfair_lock_lock(&documentCacheLock);
 
-    // Determine element type
-    UIView *view = nil;
+    NSUInteger hitCount = documentCacheHitCount;
 
-    if ([elementName isEqual:kRootTag]) {
-        if (_root == nil) {
-            [NSException raise:NSGenericException format:@"Root view is not defined."];
-        }
+    os_unfair_lock_unlock(&documentCacheLock);
 
-        view = _root;
-    } else {
-        Class type = NSClassFromString(elementName);
+    return hitCount;
+}
 
-        if ([type isSubclassOfClass:[UIView self]]) {
-            if (factory != nil) {
-                SEL selector = NSSelectorFromString(factory);
-                IMP method = [type methodForSelector:selector];
-                id (*function)(id, SEL) = (void *)method;
++ (NSUInteger)documentCacheMissCount
+{
+    os_unfair_lock_lock(&documentCacheLock);
 
-                view = function(type, selector);
-            } else {
-                view = [type new];
-            }
+    NSUInteger missCount = documentCacheMissCount;
 
-            if (view == nil) {
-                [NSException raise:NSGenericException format:@"Unable to instantiate element <%@>.", elementName];
-            }
-        }
-    }
+    os_unfair_lock_unlock(&documentCacheLock);
 
-    if (view != nil) {
-        // Apply template properties
-        if (template != nil) {
-            NSArray *components = [template componentsSeparatedByString:@","];
+    return missCount;
+}
 
-            for (NSString *component in components) {
-                NSString *name = [component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
++ (void)purgeDocumentCache
+{
+    os_unfair_lock_lock(&documentCacheLock);
 
-                NSDictionary *template = [_templates objectForKey:name];
+    [documentCache removeAllObjects];
+    [documentCacheKeys removeAllObjects];
 
-                for (NSString *key in template) {
-                    [view applyMarkupPropertyValue:[self valueForValue:[template objectForKey:key] withKeyPath:key] forKeyPath:key];
-                }
-            }
-        }
+    documentCacheSize = 0;
 
-        // Apply instance properties
-        for (NSString *key in properties) {
-            [view applyMarkupPropertyValue:[self valueForValue:[properties objectForKey:key] withKeyPath:key] forKeyPath:key];
-        }
+    os_unfair_lock_unlock(&documentCacheLock);
+}
 
-        // Apply bindings
-        for (NSString *key in bindings) {
-            [_owner bind:[bindings objectForKey:key] toView:view withKeyPath:key];
-        }
++ (LMViewDocument *)loadDocumentWithName:(NSString *)name bundle:(NSBundle *)bundle
+{
+    LMMarkupDocumentRef markupDocument = NULL;
 
-        // Add action handlers
-        for (NSNumber *key in actions) {
-            [(UIControl *)view addTarget:_owner action:NSSelectorFromString([actions objectForKey:key]) forControlEvents:[key integerValue]];
-        }
+    NSURL *url = [bundle URLForResource:name withExtension:kDocumentExtension];
 
-        // Set outlet value
-        if (outlet != nil) {
-            [_owner setValue:view forKey:outlet];
-        }
+    // Map the markup rather than copying it; it is only read when checking or parsing the document
+    NSData *data = (url == nil) ? nil : [NSData dataWithContentsOfURL:url options:NSDataReadingMappedIfSafe error:nil];
 
-        // Push onto view stack
-        [_views addObject:view];
-    } else {
-        // Process untyped element
-        if ([_views count] > 0) {
-            id superview = [_views lastObject];
+    // Prefer a compiled document, falling back to markup if it is missing, was produced by another version, or is stale
+    NSURL *compiledURL = [bundle URLForResource:name withExtension:kCompiledDocumentExtension];
 
-            if ([superview isKindOfClass:[UIView self]]) {
-                // Apply bindings
-                for (NSString *key in bindings) {
-                    [properties setObject:[_owner valueForKeyPath:[bindings objectForKey:key]] forKey:key];
-                }
+    if (compiledURL != nil) {
+        NSData *compiledData = [NSData dataWithContentsOfURL:compiledURL options:NSDataReadingMappedIfSafe error:nil];
 
-                // Notify superview
-                [superview processMarkupElement:elementName properties:properties];
-            }
+        if (compiledData != nil) {
+            markupDocument = LMMarkupDocumentDecode([compiledData bytes], [compiledData length]);
         }
 
-        // Push null view
-        [_views addObject:[NSNull null]];
-    }
-}
-
-- (id)valueForValue:(id)value withKeyPath:(NSString *)keyPath
-{
-    if ([keyPath rangeOfString:@"[Cc]olor$" options:NSRegularExpressionSearch].location != NSNotFound) {
-        value = [LMViewBuilder colorValue:[value description]];
-    } else if ([keyPath rangeOfString:@"[Ff]ont$" options:NSRegularExpressionSearch].location != NSNotFound) {
-        value = [LMViewBuilder fontValue:[value description]];
-    } else if ([keyPath rangeOfString:@"[Ii]mage$" options:NSRegularExpressionSearch].location != NSNotFound) {
-        NSBundle *bundle = [_owner bundleForImages];
+        if (markupDocument != NULL && data != nil && !LMMarkupDocumentMatchesSource(markupDocument, [data bytes], [data length])) {
+            LMMarkupDocumentRelease(markupDocument);
 
-        if (bundle == nil) {
-            bundle = [NSBundle mainBundle];
+            markupDocument = NULL;
         }
+    }
 
-        value = [UIImage imageNamed:[value description] inBundle:bundle compatibleWithTraitCollection:[_owner traitCollection]];
+    if (markupDocument == NULL && data != nil) {
+        markupDocument = [LMMarkupParser documentWithData:data];
     }
 
-    return value;
+    return (markupDocument == NULL) ? nil : [[LMViewDocument alloc] initWithMarkupDocument:markupDocument];
 }
 
-- (void)parser:(NSXMLParser *)parser didEndElement:(NSString *)elementName
-    namespaceURI:(NSString *)namespaceURI qualifiedName:(NSString *)qName
++ (NSData *)compiledDocumentAtURL:(NSURL *)url
 {
-    if (_target != nil && ![_target isEqual:[[UIDevice currentDevice] systemName]]) {
-        return;
-    }
+    LMMarkupDocumentRef markupDocument = [LMMarkupParser documentWithContentsOfURL:url];
 
-    // Pop from view stack
-    id view = [_views lastObject];
+    if (markupDocument == NULL) {
+        [NSException raise:NSInvalidArgumentException format:@"Unable to read %@.", [url lastPathComponent]];
+    }
 
-    [_views removeLastObject];
+    size_t length = 0;
+    void *bytes = LMMarkupDocumentEncode(markupDocument, &length);
 
-    if ([view isKindOfClass:[UIView self]]) {
-        if ([_views count] > 0) {
-            // Add to superview
-            id superview = [_views lastObject];
+    LMMarkupDocumentRelease(markupDocument);
 
-            if ([superview isKindOfClass:[UIView self]]) {
-                [superview appendMarkupElementView:view];
-            }
-        } else {
-            // Set root view
-            _root = view;
-        }
+    if (bytes == NULL) {
+        [NSException raise:NSMallocException format:@"Unable to encode %@.", [url lastPathComponent]];
     }
+
+    return [NSData dataWithBytesNoCopy:bytes length:length freeWhenDone:YES];
 }
 
-- (void)parser:(NSXMLParser *)parser foundCharacters:(NSString *)string
++ (UIColor *)colorValue:(NSString *)value
 {
-    if ([[string stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]] length] == 0) {
-        return;
+    UIColor *color = nil;
+
+    if ([value hasPrefix:@"#"]) {
+        color = [LMViewBuilder hexColorValue:value];
+    } else {
+        color = [LMViewBuilder namedColorValue:value];
     }
 
-    [NSException raise:NSGenericException format:@"Unexpected character content near line %ld.",
-        (long)[parser lineNumber]];
+    return color;
 }
 
-- (void)parser:(NSXMLParser *)parser foundProcessingInstructionWithTarget:(NSString *)target data:(NSString *)data
++ (UIColor *)namedColorValue:(NSString *)value
 {
-    if ([target isEqual:kCaseTarget]) {
-        _target = data;
-    } else if ([target isEqual:kEndTarget]) {
-        _target = nil;
-    } else {
-        if (_target != nil && ![_target isEqual:[[UIDevice currentDevice] systemName]]) {
-            return;
-        }
+    // Names that resolve to colors other than pattern images, and names that do not resolve, are remembered;
+    // asset catalog colors are dynamic, and color table and system colors do not depend on the trait collection
+    os_unfair_lock_lock(&namedColorsLock);
 
-        if ([target isEqual:kPropertiesTarget]) {
-            // Merge templates
-            if ([data hasPrefix:@"{"]) {
-                NSError *error = nil;
+    id color = [namedColors objectForKey:value];
 
-                NSDictionary *dictionary = [NSJSONSerialization JSONObjectWithData:[data dataUsingEncoding:NSUTF8StringEncoding]
-                    options:0 error:&error];
+    os_unfair_lock_unlock(&namedColorsLock);
 
-                if (error != nil) {
-                    [NSException raise:NSGenericException format:@"Line %ld: %@", (long)[parser lineNumber], [error description]];
-                }
+    if (color == nil) {
+        // Images are resolved against the current trait collection, so pattern colors are created on each use
+        UIImage *image = [UIImage imageNamed:value];
 
-                for (NSString *key in dictionary) {
-                    NSMutableDictionary *template = (NSMutableDictionary *)[_templates objectForKey:key];
+        if (image != nil) {
+            return [UIColor colorWithPatternImage:image];
+        }
 
-                    if (template == nil) {
-                        template = [NSMutableDictionary new];
+        color = [LMViewBuilder resolveUnpatternedColorName:value colorTable:nil];
 
-                        [_templates setObject:template forKey:key];
-                    }
+        if (color == nil) {
+            color = [NSNull null];
+        }
 
-                    [template addEntriesFromDictionary:(NSDictionary *)[dictionary objectForKey:key]];
-                }
-            }
-        } else {
-            // Notify view
-            id view = [_views lastObject];
+        os_unfair_lock_lock(&namedColorsLock);
 
-            if ([view isKindOfClass:[UIView self]]) {
-                [view processMarkupInstruction:target data:data];
-            }
-        }
+        [namedColors setObject:color forKey:value];
+
+        os_unfair_lock_unlock(&namedColorsLock);
     }
+
+    return (color == [NSNull null]) ? nil : color;
 }
 
-- (void)parser:(NSXMLParser *)parser foundCDATA:(NSData *)CDATABlock
++ (UIColor *)resolveColorName:(NSString *)value colorTable:(NSDictionary<NSString *, UIColor *> *)table
 {
-    [NSException raise:NSGenericException format:@"Unexpected CDATA content near line %ld.",
-        (long)[parser lineNumber]];
+    UIImage *image = [UIImage imageNamed:value];
+
+    if (image != nil) {
+        return [UIColor colorWithPatternImage:image];
+    }
+
+    return [LMViewBuilder resolveUnpatternedColorName:value colorTable:table];
 }
 
-- (void)parser:(NSXMLParser *)parser parseErrorOccurred:(NSError *)error
++ (UIColor *)resolveUnpatternedColorName:(NSString *)value colorTable:(NSDictionary<NSString *, UIColor *> *)table
 {
-    [NSException raise:NSGenericException format:@"A parse error occurred at line %ld, column %ld.",
-        (long)[parser lineNumber],
-        (long)[parser columnNumber]];
+    UIColor *color = nil;
+
+    if (@available(iOS 11, tvOS 11, *)) {
+        color = [UIColor colorNamed:value];
+    }
+
+    if (color == nil) {
+        // Names in the color table itself are resolved against the entries loaded so far
+        if (table == nil) {
+            table = [LMViewBuilder colorTable];
+        }
+
+        color = [table objectForKey:value];
+
+        if (color == nil) {
+            NSString *selectorName = [NSString stringWithFormat:@"%@Color", value];
+
+            if ([[UIColor self] respondsToSelector:NSSelectorFromString(selectorName)]) {
+                color = [[UIColor self] valueForKey:selectorName];
+            }
+        }
+    }
+
+    return color;
+}
+
++ (UIColor *)hexColorValue:(NSString *)value
+{
+    os_unfair_lock_lock(&hexColorsLock);
+
+    UIColor *color = [hexColors objectForKey:value];
+
+    os_unfair_lock_unlock(&hexColorsLock);
+
+    if (color == nil) {
+        char buffer[16];
+        uint8_t components[4];
+
+        if ([value getCString:buffer maxLength:sizeof(buffer) encoding:NSASCIIStringEncoding]
+            && LMMarkupParseColor(buffer, strlen(buffer), components)) {
+            color = [UIColor colorWithRed:components[0] / 255.0 green:components[1] / 255.0 blue:components[2] / 255.0
+                alpha:components[3] / 255.0];
+
+            // Create the CGColor up front; UIColor retains it, so CALayer conversions of interned colors don't allocate
+            [color CGColor];
+
+            os_unfair_lock_lock(&hexColorsLock);
+
+            [hexColors setObject:color forKey:value];
+
+            os_unfair_lock_unlock(&hexColorsLock);
+        }
+    }
+
+    return color;
+}
+
++ (NSDictionary<NSString *, UIColor *> *)colorTable
+{
+    static dispatch_once_t onceToken;
+
+    __block NSString *message = nil;
+
+    // The color table is loaded the first time a named color is requested
+    dispatch_once(&onceToken, ^{
+        NSMutableDictionary *table = [NSMutableDictionary new];
+
+        NSString *colorTablePath = [[NSBundle mainBundle] pathForResource:@"Colors" ofType:@"plist"];
+
+        if (colorTablePath != nil) {
+            NSError *error = nil;
+
+            NSDictionary *colorTableValues = [NSPropertyListSerialization propertyListWithData:[NSData dataWithContentsOfFile:colorTablePath]
+                options:0 format:nil error:&error];
+
+            if (error != nil) {
+                message = [NSString stringWithFormat:@"%@: %@", colorTablePath, [error description]];
+            }
+
+            for (NSString *key in colorTableValues) {
+                NSString *value = [[colorTableValues objectForKey:key] description];
+
+                UIColor *color;
+                if ([value hasPrefix:@"#"]) {
+                    color = [LMViewBuilder hexColorValue:value];
+                } else {
+                    color = [LMViewBuilder resolveColorName:value colorTable:table];
+                }
+
+                if (color != nil) {
+                    [table setObject:color forKey:key];
+                }
+            }
+        }
+
+        colorTable = table;
+    });
+
+    // Errors are reported only by the caller that loaded the table, after the once block has completed;
+    // subsequent lookups use the entries that could be loaded
+    if (message != nil) {
+        [NSException raise:NSGenericException format:@"%@", message];
+    }
+
+    return colorTable;
+}
+
++ (UIFont *)fontValue:(NSString *)value
+{
+    os_unfair_lock_lock(&fontsLock);
+
+    id font = [fonts objectForKey:value];
+
+    os_unfair_lock_unlock(&fontsLock);
+
+    if (font == nil) {
+        font = [LMViewBuilder resolveFontValue:value];
+
+        if (font == nil) {
+            font = [NSNull null];
+        }
+
+        os_unfair_lock_lock(&fontsLock);
+
+        [fonts setObject:font forKey:value];
+
+        os_unfair_lock_unlock(&fontsLock);
+    }
+
+    return (font == [NSNull null]) ? nil : font;
+}
+
++ (UIFont *)resolveFontValue:(NSString *)value
+{
+    const char *bytes = [value UTF8String];
+
+    LMMarkupFont spec;
+    if (bytes == NULL || !LMMarkupParseFont(bytes, strlen(bytes), &spec)) {
+        return nil;
+    }
+
+    UIFont *font = nil;
+
+    CGFloat fontSize = (CGFloat)spec.size;
+
+    switch (spec.type) {
+        case LMMarkupFontTextStyle: {
+            font = [UIFont preferredFontForTextStyle:[textStyles objectAtIndex:spec.textStyle]];
+
+            break;
+        }
+
+        case LMMarkupFontSystem: {
+            font = [UIFont systemFontOfSize:fontSize];
+
+            break;
+        }
+
+        case LMMarkupFontBoldSystem: {
+            font = [UIFont boldSystemFontOfSize:fontSize];
+
+            break;
+        }
+
+        case LMMarkupFontItalicSystem: {
+            font = [UIFont italicSystemFontOfSize:fontSize];
+
+            break;
+        }
+
+        case LMMarkupFontNamed: {
+            NSString *fontName = [[NSString alloc] initWithBytes:bytes length:spec.nameLength encoding:NSUTF8StringEncoding];
+
+            font = [UIFont fontWithName:fontName size:fontSize];
+
+            break;
+        }
+    }
+
+    return font;
+}
+
++ (LMValueType)typeOfKeyPath:(NSString *)keyPath
+{
+    os_unfair_lock_lock(&keyPathTypesLock);
+
+    NSNumber *type = [keyPathTypes objectForKey:keyPath];
+
+    os_unfair_lock_unlock(&keyPathTypesLock);
+
+    if (type == nil) {
+        if ([keyPath hasSuffix:@"Color"] || [keyPath hasSuffix:@"color"]) {
+            type = @(LMValueColor);
+        } else if ([keyPath hasSuffix:@"Font"] || [keyPath hasSuffix:@"font"]) {
+            type = @(LMValueFont);
+        } else if ([keyPath hasSuffix:@"Image"] || [keyPath hasSuffix:@"image"]) {
+            type = @(LMValueImage);
+        } else {
+            type = @(LMValueDefault);
+        }
+
+        os_unfair_lock_lock(&keyPathTypesLock);
+
+        [keyPathTypes setObject:type forKey:keyPath];
+
+        os_unfair_lock_unlock(&keyPathTypesLock);
+    }
+
+    return [type intValue];
+}
+
++ (id)templateValueForValue:(id)value withKeyPath:(NSString *)keyPath
+{
+    // Values that depend on the owner or on the current content size category are converted when applied
+    switch ([LMViewBuilder typeOfKeyPath:keyPath]) {
+        case LMValueColor: {
+            value = [LMViewBuilder colorValue:[value description]];
+
+            break;
+        }
+
+        case LMValueFont: {
+            UIFont *font = [LMViewBuilder fontValue:[value description]];
+
+            value = ([[font fontDescriptor] objectForKey:UIFontDescriptorTextStyleAttribute] == nil) ? font : nil;
+
+            break;
+        }
+
+        case LMValueImage: {
+            value = nil;
+
+            break;
+        }
+
+        case LMValueDefault: {
+            break;
+        }
+    }
+
+    return value;
+}
+
++ (LMAttributeType)typeOfKey:(NSString *)key event:(UIControlEvents *)event
+{
+    NSNumber *type = [attributeTypes objectForKey:key];
+
+    if (type != nil) {
+        return [type intValue];
+    }
+
+    NSNumber *controlEvent = [attributeEvents objectForKey:key];
+
+    if (controlEvent != nil) {
+        *event = [controlEvent unsignedIntegerValue];
+
+        return LMAttributeAction;
+    }
+
+    return LMAttributeProperty;
+}
+
++ (LMAttributeValueType)typeOfValue:(NSString *)value
+{
+    if ([value hasPrefix:kBindingPrefix]) {
+        return LMAttributeValueBinding;
+    } else if ([value hasPrefix:kLocalizedStringPrefix]) {
+        return LMAttributeValueLocalizedString;
+    } else if ([value hasPrefix:kEscapePrefix]) {
+        return LMAttributeValueEscaped;
+    } else {
+        return LMAttributeValuePlain;
+    }
+}
+
+- (instancetype)initWithOwner:(id)owner root:(UIView *)root
+{
+    self = [super init];
+
+    if (self) {
+        _owner = owner;
+        _root = root;
+
+        _templates = [[LMTemplateRegistry alloc] initWithTemplates:@{}];
+        _templatesModified = NO;
+
+        _views = [NSMutableArray new];
+
+        _target = nil;
+
+        _colors = [NSMutableDictionary new];
+        _fonts = [NSMutableDictionary new];
+        _images = [NSMutableDictionary new];
+    }
+
+    return self;
+}
+
+- (UIView *)root
+{
+    return _root;
+}
+
+- (void)build:(LMViewDocument *)document
+{
+    LMMarkupDocumentRef markupDocument = [document markupDocument];
+
+    NSArray *strings = [document strings];
+
+    for (uint32_t i = 0, n = LMMarkupDocumentGetNodeCount(markupDocument); i < n; i++) {
+        const LMMarkupNode *node = LMMarkupDocumentGetNode(markupDocument, i);
+
+        switch (node->type) {
+            case LMMarkupNodeStartElement: {
+                [self startElement:node document:document];
+
+                break;
+            }
+
+            case LMMarkupNodeEndElement: {
+                [self endElement];
+
+                break;
+            }
+
+            case LMMarkupNodeInstruction: {
+                [self processInstruction:[strings objectAtIndex:node->name] data:[strings objectAtIndex:node->data] line:node->line];
+
+                break;
+            }
+
+            case LMMarkupNodeProperties: {
+                [self mergeTemplates:i document:document];
+
+                break;
+            }
+        }
+    }
+}
+
+- (NSString *)localizedStringForKey:(NSString *)key value:(NSString *)value
+{
+    // The string bundle and table are resolved on first use, once per load
+    if (_strings == nil) {
+        _stringBundle = [_owner bundleForStrings];
+
+        if (_stringBundle == nil) {
+            _stringBundle = [NSBundle mainBundle];
+        }
+
+        _stringTable = [_owner tableForStrings];
+
+        _strings = [LMViewBuilder stringTableWithName:_stringTable bundle:_stringBundle];
+    }
+
+    NSString *string = [_strings objectForKey:key];
+
+    if (string == nil) {
+        // Strings that are not in the preloaded table, such as those defined in .stringsdict files, are
+        // resolved by the bundle
+        string = [_stringBundle localizedStringForKey:key value:value table:_stringTable];
+    }
+
+    return string;
+}
+
++ (NSDictionary<NSString *, NSString *> *)stringTableWithName:(NSString *)name bundle:(NSBundle *)bundle
+{
+    if (name == nil) {
+        name = kDefaultStringTable;
+    }
+
+    NSString *key = [NSString stringWithFormat:@"%@/%@", [bundle bundlePath], name];
+
+    os_unfair_lock_lock(&stringTablesLock);
+
+    NSDictionary *strings = [stringTables objectForKey:key];
+
+    os_unfair_lock_unlock(&stringTablesLock);
+
+    if (strings == nil) {
+        // Resource lookup selects the table for the bundle's preferred localization
+        NSString *path = [bundle pathForResource:name ofType:kStringTableExtension];
+
+        NSData *data = (path == nil) ? nil : [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:nil];
+
+        if (data != nil) {
+            strings = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:nil error:nil];
+        }
+
+        if (![strings isKindOfClass:[NSDictionary self]]) {
+            strings = @{};
+        }
+
+        os_unfair_lock_lock(&stringTablesLock);
+
+        [stringTables setObject:strings forKey:key];
+
+        os_unfair_lock_unlock(&stringTablesLock);
+    }
+
+    return strings;
+}
+
+- (void)startElement:(const LMMarkupNode *)node document:(LMViewDocument *)document
+{
+    if (_target != nil && ![_target isEqual:[[UIDevice currentDevice] systemName]]) {
+        return;
+    }
+
+    LMMarkupDocumentRef markupDocument = [document markupDocument];
+
+    NSArray *strings = [document strings];
+
+    NSString *elementName = [strings objectAtIndex:node->name];
+
+    NSString *factory = nil;
+    NSString *template = nil;
+    NSString *outlet = nil;
+    NSMutableDictionary *actions = [NSMutableDictionary new];
+    NSMutableDictionary *bindings = [NSMutableDictionary new];
+    NSMutableDictionary *properties = [NSMutableDictionary new];
+
+    for (uint32_t i = 0; i < node->count; i++) {
+        const LMMarkupAttribute *attribute = LMMarkupDocumentGetAttribute(markupDocument, node->first + i);
+
+        NSString *key = [strings objectAtIndex:attribute->key];
+        NSString *value = [strings objectAtIndex:attribute->value];
+
+        // Keys and values are classified once per document
+        switch ([document typeOfKey:attribute->key]) {
+            case LMAttributeFactory: {
+                factory = value;
+
+                break;
+            }
+
+            case LMAttributeTemplate: {
+                template = value;
+
+                break;
+            }
+
+            case LMAttributeOutlet: {
+                outlet = value;
+
+                break;
+            }
+
+            case LMAttributeAction: {
+                [actions setObject:value forKey:@([document eventForKey:attribute->key])];
+
+                break;
+            }
+
+            case LMAttributeProperty: {
+                switch ([document typeOfValue:attribute->value]) {
+                    case LMAttributeValueBinding: {
+                        [bindings setObject:[value substringFromIndex:[kBindingPrefix length]] forKey:key];
+
+                        break;
+                    }
+
+                    case LMAttributeValueLocalizedString: {
+                        [properties setObject:[self localizedStringForKey:[value substringFromIndex:[kLocalizedStringPrefix length]] value:value] forKey:key];
+
+                        break;
+                    }
+
+                    case LMAttributeValueEscaped: {
+                        [properties setObject:[value substringFromIndex:[kEscapePrefix length]] forKey:key];
+
+                        break;
+                    }
+
+                    case LMAttributeValuePlain: {
+                        [properties setObject:value forKey:key];
+
+                        break;
+                    }
+                }
+
+                break;
+            }
+        }
+    }
+
+    // Determine element type
+    UIView *view = nil;
+
+    if ([elementName isEqual:kRootTag]) {
+        if (_root == nil) {
+            [NSException raise:NSGenericException format:@"Root view is not defined."];
+        }
+
+        view = _root;
+    } else {
+        Class type = NSClassFromString(elementName);
+
+        if ([type isSubclassOfClass:[UIView self]]) {
+            if (factory != nil) {
+                SEL selector = NSSelectorFromString(factory);
+                IMP method = [type methodForSelector:selector];
+                id (*function)(id, SEL) = (void *)method;
+
+                view = function(type, selector);
+            } else {
+                view = [type new];
+            }
+
+            if (view == nil) {
+                [NSException raise:NSGenericException format:@"Unable to instantiate element <%@>.", elementName];
+            }
+        }
+    }
+
+    if (view != nil) {
+        // Apply template properties
+        if (template != nil) {
+            [self applyTemplate:[_templates templateForClasses:template] toView:view];
+        }
+
+        // Apply instance properties
+        for (NSString *key in properties) {
+            [view applyMarkupPropertyValue:[self valueForValue:[properties objectForKey:key] withKeyPath:key] forKeyPath:key];
+        }
+
+        // Apply bindings
+        for (NSString *key in bindings) {
+            [_owner bind:[bindings objectForKey:key] toView:view withKeyPath:key];
+        }
+
+        // Add action handlers
+        for (NSNumber *key in actions) {
+            [(UIControl *)view addTarget:_owner action:NSSelectorFromString([actions objectForKey:key]) forControlEvents:[key integerValue]];
+        }
+
+        // Set outlet value
+        if (outlet != nil) {
+            [_owner setValue:view forKey:outlet];
+        }
+
+        // Push onto view stack
+        [_views addObject:view];
+    } else {
+        // Process untyped element
+        if ([_views count] > 0) {
+            id superview = [_views lastObject];
+
+            if ([superview isKindOfClass:[UIView self]]) {
+                // Apply bindings
+                for (NSString *key in bindings) {
+                    [properties setObject:[_owner valueForKeyPath:[bindings objectForKey:key]] forKey:key];
+                }
+
+                // Notify superview
+                [superview processMarkupElement:elementName properties:properties];
+            }
+        }
+
+        // Push null view
+        [_views addObject:[NSNull null]];
+    }
+}
+
+- (void)applyTemplate:(LMTemplate *)template toView:(UIView *)view
+{
+    for (NSUInteger i = 0, n = [template count]; i < n; i++) {
+        NSString *keyPath = [template keyPathAtIndex:i];
+
+        id value = [template valueAtIndex:i];
+
+        if ([template isDeferredAtIndex:i]) {
+            value = [self valueForValue:value withKeyPath:keyPath];
+        }
+
+        [view applyMarkupPropertyValue:value forKeyPath:keyPath];
+    }
+}
+
+- (id)valueForValue:(id)value withKeyPath:(NSString *)keyPath
+{
+    LMValueType type = [LMViewBuilder typeOfKeyPath:keyPath];
+
+    if (type == LMValueDefault) {
+        return value;
+    }
+
+    // Converted values are memoized by source string for the duration of the load, during which
+    // the owner's bundle and trait collection don't change
+    NSString *source = [value description];
+
+    NSMutableDictionary *values;
+    switch (type) {
+        case LMValueColor: {
+            values = _colors;
+
+            break;
+        }
+
+        case LMValueFont: {
+            values = _fonts;
+
+            break;
+        }
+
+        default: {
+            values = _images;
+
+            break;
+        }
+    }
+
+    value = [values objectForKey:source];
+
+    if (value == nil) {
+        switch (type) {
+            case LMValueColor: {
+                value = [LMViewBuilder colorValue:source];
+
+                break;
+            }
+
+            case LMValueFont: {
+                value = [LMViewBuilder fontValue:source];
+
+                break;
+            }
+
+            default: {
+                NSBundle *bundle = [_owner bundleForImages];
+
+                if (bundle == nil) {
+                    bundle = [NSBundle mainBundle];
+                }
+
+                value = [UIImage imageNamed:source inBundle:bundle compatibleWithTraitCollection:[_owner traitCollection]];
+
+                break;
+            }
+        }
+
+        if (value == nil) {
+            value = [NSNull null];
+        }
+
+        [values setObject:value forKey:source];
+    }
+
+    return (value == [NSNull null]) ? nil : value;
+}
+
+- (void)endElement
+{
+    if (_target != nil && ![_target isEqual:[[UIDevice currentDevice] systemName]]) {
+        return;
+    }
+
+    // Pop from view stack
+    id view = [_views lastObject];
+
+    [_views removeLastObject];
+
+    if ([view isKindOfClass:[UIView self]]) {
+        if ([_views count] > 0) {
+            // Add to superview
+            id superview = [_views lastObject];
+
+            if ([superview isKindOfClass:[UIView self]]) {
+                [superview appendMarkupElementView:view];
+            }
+        } else {
+            // Set root view
+            _root = view;
+        }
+    }
+}
+
+- (void)processInstruction:(NSString *)target data:(NSString *)data line:(uint32_t)line
+{
+    if ([target isEqual:kCaseTarget]) {
+        _target = data;
+    } else if ([target isEqual:kEndTarget]) {
+        _target = nil;
+    } else {
+        if (_target != nil && ![_target isEqual:[[UIDevice currentDevice] systemName]]) {
+            return;
+        }
+
+        if ([target isEqual:kPropertiesTarget]) {
+            // Merge templates
+            if ([data hasPrefix:@"{"]) {
+                NSError *error = nil;
+
+                NSDictionary *dictionary = [NSJSONSerialization JSONObjectWithData:[data dataUsingEncoding:NSUTF8StringEncoding]
+                    options:0 error:&error];
+
+                if (error != nil) {
+                    [NSException raise:NSGenericException format:@"Line %ld: %@", (long)line, [error description]];
+                }
+
+                _templates = [_templates registryByMergingTemplates:dictionary];
+                _templatesModified = YES;
+            }
+        } else {
+            // Notify view
+            id view = [_views lastObject];
+
+            if ([view isKindOfClass:[UIView self]]) {
+                [view processMarkupInstruction:target data:data];
+            }
+        }
+    }
+}
+
+- (void)mergeTemplates:(uint32_t)index document:(LMViewDocument *)document
+{
+    if (_target != nil && ![_target isEqual:[[UIDevice currentDevice] systemName]]) {
+        return;
+    }
+
+    // Use the document's pre-merged registry unless templates were added that the document doesn't know about
+    if (_templatesModified) {
+        _templates = [_templates registryByMergingTemplates:[document templatesForNode:index]];
+    } else {
+        _templates = [document templateRegistryForNode:index];
+    }
+}
+
+@end
+
+@implementation LMViewDocument
+{
+    NSDictionary<NSNumber *, NSDictionary *> *_templates;
+    NSDictionary<NSNumber *, LMTemplateRegistry *> *_templateRegistries;
+
+    uint8_t *_stringTypes;
+    UIControlEvents *_keyEvents;
+}
+
+- (instancetype)initWithMarkupDocument:(LMMarkupDocumentRef)markupDocument
+{
+    self = [super init];
+
+    if (self) {
+        _markupDocument = markupDocument;
+
+        // Approximate the memory occupied by the document and its decoded strings and templates
+        NSUInteger size = LMMarkupDocumentGetSize(markupDocument);
+
+        uint32_t n = LMMarkupDocumentGetStringCount(markupDocument);
+
+        NSMutableArray *strings = [[NSMutableArray alloc] initWithCapacity:n];
+
+        for (uint32_t i = 0; i < n; i++) {
+            size_t length;
+            const char *bytes = LMMarkupDocumentGetString(markupDocument, i, &length);
+
+            NSString *string = [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+
+            if (string == nil) {
+                [NSException raise:NSGenericException format:@"Invalid string in markup document."];
+            }
+
+            [strings addObject:string];
+
+            size += sizeof(void *) * 4 + length * sizeof(unichar);
+        }
+
+        _strings = strings;
+
+        // Classify attribute keys and values by string index; the key type occupies the low nibble
+        // and the value type the high nibble, since the same string may be used as both
+        _stringTypes = calloc(MAX(n, 1), sizeof(uint8_t));
+        _keyEvents = calloc(MAX(n, 1), sizeof(UIControlEvents));
+
+        if (_stringTypes == NULL || _keyEvents == NULL) {
+            [NSException raise:NSMallocException format:@"Unable to allocate document."];
+        }
+
+        for (uint32_t i = 0, n = LMMarkupDocumentGetNodeCount(markupDocument); i < n; i++) {
+            const LMMarkupNode *node = LMMarkupDocumentGetNode(markupDocument, i);
+
+            if (node->type != LMMarkupNodeStartElement) {
+                continue;
+            }
+
+            for (uint32_t j = 0; j < node->count; j++) {
+                const LMMarkupAttribute *attribute = LMMarkupDocumentGetAttribute(markupDocument, node->first + j);
+
+                UIControlEvents event = 0;
+                LMAttributeType keyType = [LMViewBuilder typeOfKey:[strings objectAtIndex:attribute->key] event:&event];
+
+                _stringTypes[attribute->key] = (_stringTypes[attribute->key] & 0xF0) | keyType;
+                _keyEvents[attribute->key] = event;
+
+                LMAttributeValueType valueType = [LMViewBuilder typeOfValue:[strings objectAtIndex:attribute->value]];
+
+                _stringTypes[attribute->value] = (_stringTypes[attribute->value] & 0x0F) | (valueType << 4);
+            }
+        }
+
+        size += n * (sizeof(uint8_t) + sizeof(UIControlEvents));
+
+        NSMutableDictionary *templates = [NSMutableDictionary new];
+        NSMutableDictionary *templateRegistries = [NSMutableDictionary new];
+
+        LMTemplateRegistry *templateRegistry = [[LMTemplateRegistry alloc] initWithTemplates:@{}];
+
+        // Merge templates in document order, skipping blocks that don't apply to this device
+        NSString *systemName = [[UIDevice currentDevice] systemName];
+        NSString *target = nil;
+
+        for (uint32_t i = 0, n = LMMarkupDocumentGetNodeCount(markupDocument); i < n; i++) {
+            const LMMarkupNode *node = LMMarkupDocumentGetNode(markupDocument, i);
+
+            if (node->type == LMMarkupNodeInstruction) {
+                NSString *name = [_strings objectAtIndex:node->name];
+
+                if ([name isEqual:kCaseTarget]) {
+                    target = [_strings objectAtIndex:node->data];
+                } else if ([name isEqual:kEndTarget]) {
+                    target = nil;
+                }
+            } else if (node->type == LMMarkupNodeProperties) {
+                NSDictionary *nodeTemplates = [self templatesForPropertiesNode:node];
+
+                [templates setObject:nodeTemplates forKey:@(i)];
+
+                if (target == nil || [target isEqual:systemName]) {
+                    templateRegistry = [templateRegistry registryByMergingTemplates:nodeTemplates];
+                }
+
+                [templateRegistries setObject:templateRegistry forKey:@(i)];
+
+                size += node->count * sizeof(void *) * 16;
+            }
+        }
+
+        _templates = templates;
+        _templateRegistries = templateRegistries;
+
+        _size = size;
+    }
+
+    return self;
+}
+
+- (void)dealloc
+{
+    LMMarkupDocumentRelease(_markupDocument);
+
+    free(_stringTypes);
+    free(_keyEvents);
+}
+
+- (NSDictionary *)templatesForPropertiesNode:(const LMMarkupNode *)node
+{
+    NSMutableDictionary *templates = [[NSMutableDictionary alloc] initWithCapacity:node->count];
+
+    for (uint32_t i = 0; i < node->count; i++) {
+        const LMMarkupTemplate *markupTemplate = LMMarkupDocumentGetTemplate(_markupDocument, node->first + i);
+
+        NSMutableDictionary *template = [[NSMutableDictionary alloc] initWithCapacity:markupTemplate->count];
+
+        for (uint32_t j = 0; j < markupTemplate->count; j++) {
+            const LMMarkupProperty *property = LMMarkupDocumentGetProperty(_markupDocument, markupTemplate->first + j);
+
+            id value;
+            switch (property->type) {
+                case LMMarkupValueString: {
+                    value = [_strings objectAtIndex:property->string];
+
+                    break;
+                }
+
+                case LMMarkupValueNumber: {
+                    value = [NSNumber numberWithDouble:property->number];
+
+                    break;
+                }
+
+                case LMMarkupValueBoolean: {
+                    value = [NSNumber numberWithBool:property->number != 0];
+
+                    break;
+                }
+
+                case LMMarkupValueInteger: {
+                    value = [NSNumber numberWithLongLong:property->integer];
+
+                    break;
+                }
+
+                default: {
+                    value = [NSNull null];
+
+                    break;
+                }
+            }
+
+            [template setObject:value forKey:[_strings objectAtIndex:property->key]];
+        }
+
+        NSString *name = [_strings objectAtIndex:markupTemplate->name];
+
+        // Later declarations of the same template within a block take precedence
+        NSMutableDictionary *existingTemplate = [templates objectForKey:name];
+
+        if (existingTemplate != nil) {
+            [existingTemplate addEntriesFromDictionary:template];
+        } else {
+            [templates setObject:template forKey:name];
+        }
+    }
+
+    return templates;
+}
+
+- (NSDictionary<NSString *, NSDictionary *> *)templatesForNode:(uint32_t)index
+{
+    return [_templates objectForKey:@(index)];
+}
+
+- (LMTemplateRegistry *)templateRegistryForNode:(uint32_t)index
+{
+    return [_templateRegistries objectForKey:@(index)];
+}
+
+- (LMAttributeType)typeOfKey:(uint32_t)index
+{
+    return _stringTypes[index] & 0x0F;
+}
+
+- (UIControlEvents)eventForKey:(uint32_t)index
+{
+    return _keyEvents[index];
+}
+
+- (LMAttributeValueType)typeOfValue:(uint32_t)index
+{
+    return _stringTypes[index] >> 4;
+}
+
+@end
+
+@implementation LMTemplate
+{
+    NSArray<NSString *> *_keyPaths;
+    NSArray *_values;
+
+    BOOL *_deferred;
+}
+
+- (instancetype)initWithProperties:(NSDictionary *)properties
+{
+    self = [super init];
+
+    if (self) {
+        _properties = properties;
+
+        _count = [properties count];
+
+        NSMutableArray *keyPaths = [[NSMutableArray alloc] initWithCapacity:_count];
+        NSMutableArray *values = [[NSMutableArray alloc] initWithCapacity:_count];
+
+        _deferred = calloc(MAX(_count, 1), sizeof(BOOL));
+
+        if (_deferred == NULL) {
+            [NSException raise:NSMallocException format:@"Unable to allocate template."];
+        }
+
+        for (NSString *keyPath in properties) {
+            id value = [properties objectForKey:keyPath];
+            id templateValue = [LMViewBuilder templateValueForValue:value withKeyPath:keyPath];
+
+            if (templateValue == nil) {
+                _deferred[[values count]] = YES;
+            } else {
+                value = templateValue;
+            }
+
+            [keyPaths addObject:keyPath];
+            [values addObject:value];
+        }
+
+        _keyPaths = keyPaths;
+        _values = values;
+    }
+
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_deferred);
+}
+
+- (NSString *)keyPathAtIndex:(NSUInteger)index
+{
+    return [_keyPaths objectAtIndex:index];
+}
+
+- (id)valueAtIndex:(NSUInteger)index
+{
+    return [_values objectAtIndex:index];
+}
+
+- (BOOL)isDeferredAtIndex:(NSUInteger)index
+{
+    return _deferred[index];
+}
+
+@end
+
+@implementation LMTemplateRegistry
+{
+    NSDictionary<NSString *, LMTemplate *> *_templates;
+
+    NSMutableDictionary<NSString *, id> *_classTemplates;
+    os_unfair_lock _classTemplatesLock;
+}
+
+- (instancetype)initWithTemplates:(NSDictionary<NSString *, LMTemplate *> *)templates
+{
+    self = [super init];
+
+    if (self) {
+        _templates = templates;
+
+        _classTemplates = [NSMutableDictionary new];
+        _classTemplatesLock = OS_UNFAIR_LOCK_INIT;
+    }
+
+    return self;
+}
+
+- (LMTemplateRegistry *)registryByMergingTemplates:(NSDictionary<NSString *, NSDictionary *> *)templates
+{
+    NSMutableDictionary *mergedTemplates = [_templates mutableCopy];
+
+    for (NSString *name in templates) {
+        NSMutableDictionary *properties = [[[_templates objectForKey:name] properties] mutableCopy];
+
+        if (properties == nil) {
+            properties = [NSMutableDictionary new];
+        }
+
+        [properties addEntriesFromDictionary:(NSDictionary *)[templates objectForKey:name]];
+
+        [mergedTemplates setObject:[[LMTemplate alloc] initWithProperties:properties] forKey:name];
+    }
+
+    return [[LMTemplateRegistry alloc] initWithTemplates:mergedTemplates];
+}
+
+- (LMTemplate *)templateForName:(NSString *)name
+{
+    return [_templates objectForKey:name];
+}
+
+- (LMTemplate *)templateForClasses:(NSString *)classes
+{
+    os_unfair_lock_lock(&_classTemplatesLock);
+
+    id template = [_classTemplates objectForKey:classes];
+
+    os_unfair_lock_unlock(&_classTemplatesLock);
+
+    if (template == nil) {
+        template = [self resolveClasses:classes];
+
+        if (template == nil) {
+            template = [NSNull null];
+        }
+
+        os_unfair_lock_lock(&_classTemplatesLock);
+
+        [_classTemplates setObject:template forKey:classes];
+
+        os_unfair_lock_unlock(&_classTemplatesLock);
+    }
+
+    return (template == [NSNull null]) ? nil : template;
+}
+
+- (LMTemplate *)resolveClasses:(NSString *)classes
+{
+    // Flatten the listed templates into a single property set; later templates take precedence
+    NSMutableArray *templates = [NSMutableArray new];
+
+    for (NSString *component in [classes componentsSeparatedByString:@","]) {
+        LMTemplate *template = [_templates objectForKey:[component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]]];
+
+        if (template != nil) {
+            [templates addObject:template];
+        }
+    }
+
+    if ([templates count] < 2) {
+        return [templates firstObject];
+    }
+
+    NSMutableDictionary *properties = [NSMutableDictionary new];
+
+    for (LMTemplate *template in templates) {
+        [properties addEntriesFromDictionary:[template properties]];
+    }
+
+    return [[LMTemplate alloc] initWithProperties:properties];
+}
+
+@end
+
+@implementation LMMarkupParser
+
++ (LMMarkupDocumentRef)documentWithContentsOfURL:(NSURL *)url
+{
+    // Map the markup rather than copying it; the reader refers to it directly
+    NSData *data = [NSData dataWithContentsOfURL:url options:NSDataReadingMappedIfSafe error:nil];
+
+    return (data == nil) ? NULL : [LMMarkupParser documentWithData:data];
+}
+
++ (LMMarkupDocumentRef)documentWithData:(NSData *)data
+{
+    LMMarkupError error;
+    uint32_t line, column;
+
+    LMMarkupDocumentRef document = LMMarkupCompile([data bytes], [data length], &error, &line, &column);
+
+    if (document == NULL) {
+        [LMMarkupParser raiseError:error line:line column:column];
+    }
+
+    return document;
+}
+
++ (void)raiseError:(LMMarkupError)error line:(uint32_t)line column:(uint32_t)column
+{
+    switch (error) {
+        case LMMarkupErrorCharacters: {
+            [NSException raise:NSGenericException format:@"Unexpected character content near line %ld.",
+                (long)line];
+
+            break;
+        }
+
+        case LMMarkupErrorCDATA: {
+            [NSException raise:NSGenericException format:@"Unexpected CDATA content near line %ld.",
+                (long)line];
+
+            break;
+        }
+
+        case LMMarkupErrorMemory: {
+            [NSException raise:NSMallocException format:@"Unable to allocate markup document."];
+
+            break;
+        }
+
+        case LMMarkupErrorEncoding: {
+            [NSException raise:NSGenericException format:@"Invalid character at line %ld, column %ld.",
+                (long)line,
+                (long)column];
+
+            break;
+        }
+
+        default: {
+            [NSException raise:NSGenericException format:@"A parse error occurred at line %ld, column %ld.",
+                (long)line,
+                (long)column];
+
+            break;
+        }
+    }
 }
 
 @end
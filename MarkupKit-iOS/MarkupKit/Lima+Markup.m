@@ -15,6 +15,7 @@
 #import "Foundation+Markup.h"
 #import "UIKit+Markup.h"
 #import "Lima+Markup.h"
+#import "LMPropertyConverter.h"
 
 #import <objc/message.h>
 
@@ -29,58 +30,58 @@
 
 @implementation LMBoxView (Markup)
 
-static NSDictionary *horizontalAlignmentValues;
-static NSDictionary *verticalAlignmentValues;
+static const LMEnumEntry horizontalAlignmentEntries[] = {
+    {"fill", LMHorizontalAlignmentFill},
+    {"leading", LMHorizontalAlignmentLeading},
+    {"trailing", LMHorizontalAlignmentTrailing},
+    {"center", LMHorizontalAlignmentCenter}
+};
 
-+ (void)initialize
-{
-    horizontalAlignmentValues = @{
-        @"fill": @(LMHorizontalAlignmentFill),
-        @"leading": @(LMHorizontalAlignmentLeading),
-        @"trailing": @(LMHorizontalAlignmentTrailing),
-        @"center": @(LMHorizontalAlignmentCenter)
-    };
-
-    verticalAlignmentValues = @{
-        @"fill": @(LMVerticalAlignmentFill),
-        @"top": @(LMVerticalAlignmentTop),
-        @"bottom": @(LMVerticalAlignmentBottom),
-        @"center": @(LMVerticalAlignmentCenter)
-    };
-}
+static LMEnumTable horizontalAlignmentValues = LMEnumTableMake(horizontalAlignmentEntries);
+
+static const LMEnumEntry verticalAlignmentEntries[] = {
+    {"fill", LMVerticalAlignmentFill},
+    {"top", LMVerticalAlignmentTop},
+    {"bottom", LMVerticalAlignmentBottom},
+    {"center", LMVerticalAlignmentCenter}
+};
+
+static LMEnumTable verticalAlignmentValues = LMEnumTableMake(verticalAlignmentEntries);
+
+static const LMPropertyConverter boxViewPropertyConverters[] = {
+    {"horizontalAlignment", &horizontalAlignmentValues, NULL},
+    {"verticalAlignment", &verticalAlignmentValues, NULL}
+};
 
-- (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
 {
-    if ([key isEqual:@"horizontalAlignment"]) {
-        value = [horizontalAlignmentValues objectForKey:value];
-    } else if ([key isEqual:@"verticalAlignment"]) {
-        value = [verticalAlignmentValues objectForKey:value];
-    }
+    const LMPropertyConverter *converter = LMFindPropertyConverter(boxViewPropertyConverters,
+        LMPropertyConverterCount(boxViewPropertyConverters), key);
 
-    [super applyMarkupPropertyValue:value forKey:key];
+    return (converter == NULL) ? [super propertyConverterForKey:key] : converter;
 }
 
 @end
 
 @implementation LMRowView (Markup)
 
-static NSDictionary *baselineValues;
+static const LMEnumEntry baselineEntries[] = {
+    {"first", LMBaselineFirst},
+    {"last", LMBaselineLast}
+};
 
-+ (void)initialize
-{
-    baselineValues = @{
-        @"first": @(LMBaselineFirst),
-        @"last": @(LMBaselineLast)
-    };
-}
+static LMEnumTable baselineValues = LMEnumTableMake(baselineEntries);
 
-- (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
+static const LMPropertyConverter rowViewPropertyConverters[] = {
+    {"baseline", &baselineValues, NULL}
+};
+
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
 {
-    if ([key isEqual:@"baseline"]) {
-        value = [baselineValues objectForKey:value];
-    }
+    const LMPropertyConverter *converter = LMFindPropertyConverter(rowViewPropertyConverters,
+        LMPropertyConverterCount(rowViewPropertyConverters), key);
 
-    [super applyMarkupPropertyValue:value forKey:key];
+    return (converter == NULL) ? [super propertyConverterForKey:key] : converter;
 }
 
 @end
@@ -40,12 +40,73 @@ NS_ASSUME_NONNULL_BEGIN
 
 /**
  * Returns a named formatter, or <code>nil</code> if no formatter with the given name exists.
+ * Bindings request a formatter once and reuse it until the current locale or system time
+ * zone changes.
  *
  * @param name The formatter name.
  * @param arguments The formatter arguments.
  */
 - (nullable NSFormatter *)formatterWithName:(NSString *)name arguments:(NSDictionary<NSString *, id> *)arguments;
 
+/**
+ * Indicates that bindings established by this object should coalesce updates. When a bound
+ * expression changes, a coalescing binding is marked as pending rather than updated immediately,
+ * and pending bindings are updated once per run loop iteration, grouped by owner. Bindings
+ * established while a document is being loaded receive their initial values when the load
+ * completes. The default implementation returns <code>NO</code>.
+ */
+- (BOOL)coalescesBindingUpdates;
+
+/**
+ * Indicates that bindings established by this object should be suspended while their views are
+ * offscreen. A view is considered offscreen when it is not in a window or when it belongs to a page
+ * of an <code>LMPageView</code> that has been scrolled out of view. Changes to a suspended binding
+ * are not applied; the binding is updated once when its view becomes visible again. The default
+ * implementation returns <code>NO</code>.
+ */
+- (BOOL)suspendsOffscreenBindings;
+
+/**
+ * Indicates that formatted bindings established by this object should format their values on a
+ * background queue. The bound view is updated on the main thread when formatting completes; results
+ * are cached by formatter and value, and a result that has been superseded by a later change is
+ * discarded. Values are formatted on a serial queue using formatter instances that are separate from
+ * those used on the main thread; unless the owner overrides <code>formatterWithName:arguments:</code>,
+ * one such instance per formatter is shared by all owners. Initial values, and values that do not
+ * conform to <code>NSCopying</code>, are formatted on the main thread. Overrides of
+ * <code>formatterWithName:arguments:</code> are called separately for each context and should not
+ * return the same instance to both. The default implementation returns <code>NO</code>.
+ */
+- (BOOL)formatsBindingValuesAsynchronously;
+
+/**
+ * Returns the number of times a binding has evaluated its expression and updated its view.
+ *
+ * @return The binding update count.
+ */
++ (NSUInteger)bindingUpdateCount;
+
+/**
+ * Returns the number of changes that were absorbed by a coalescing binding's pending update.
+ *
+ * @return The coalesced binding update count.
+ */
++ (NSUInteger)coalescedBindingUpdateCount;
+
+/**
+ * Returns the number of binding updates that were skipped because the bound view was offscreen.
+ *
+ * @return The suspended binding update count.
+ */
++ (NSUInteger)suspendedBindingUpdateCount;
+
+/**
+ * Returns the number of binding writes that were skipped because the value was unchanged.
+ *
+ * @return The unchanged binding value count.
+ */
++ (NSUInteger)unchangedBindingValueCount;
+
 /**
  * Establishes a binding between this object and a view instance.
  *
@@ -55,11 +116,38 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)bind:(NSString *)expression toView:(UIView *)view withKeyPath:(NSString *)keyPath;
 
+/**
+ * Replaces the value of a property referenced by this object's bindings, retargeting the existing
+ * bindings rather than rebuilding them. Observers are moved from the property's current value to
+ * the new value, and each dependent binding is evaluated once. Only bound view properties are
+ * updated, so reused cells can call this method in place of <code>unbindAll</code> followed by
+ * new bindings.
+ *
+ * @param key The property key.
+ * @param source The new value.
+ */
+- (void)rebind:(NSString *)key toSource:(nullable id)source;
+
 /**
  * Releases all bindings.
  */
 - (void)unbindAll;
 
+/**
+ * Returns the number of bindings established by this object whose views are still alive.
+ *
+ * @return The live binding count.
+ */
+- (NSUInteger)liveBindingCount;
+
+/**
+ * Returns the number of bindings established by this object whose views have been deallocated.
+ * Such bindings are removed automatically the next time one of their key paths changes.
+ *
+ * @return The dead binding count.
+ */
+- (NSUInteger)deadBindingCount;
+
 @end
 
 @interface UIView (Markup)
@@ -139,6 +227,17 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic) CGFloat trailingSpacing;
 
+/**
+ * Indicates that a binding should write its value to the given key path even when the value is
+ * unchanged since the previous write. Bindings normally skip such writes; views whose properties
+ * have side effects or that the user can change can override this method to return <code>YES</code>
+ * for those properties. The default implementation returns <code>NO</code>; MarkupKit's extensions
+ * to editable controls return <code>YES</code> for their user-editable properties.
+ *
+ * @param keyPath The bound key path.
+ */
+- (BOOL)writesUnchangedBindingValueForKeyPath:(NSString *)keyPath;
+
 /**
  * Processes a markup instruction.
  *
@@ -14,26 +14,14 @@
 
 #import "Foundation+Markup.h"
 #import "UIKit+Markup.h"
+#import "LMPropertyConverter.h"
+#import "LMBinding.h"
 
 #import <Lima/UIKit+Lima.h>
 #import <objc/message.h>
 
 #import "LMViewBuilder.h"
 
-@interface LMBinding : NSObject
-
-@property (nonatomic, readonly) NSExpression *expression;
-
-@property (weak, nonatomic, readonly) UIView *view;
-@property (nonatomic, readonly) NSString *keyPath;
-
-- (instancetype)initWithExpression:(NSString *)expression view:(UIView *)view keyPath:(NSString *)keyPath;
-
-- (void)bindTo:(id)owner;
-- (void)unbindFrom:(id)owner;
-
-@end
-
 @implementation UIResponder (Markup)
 
 - (NSBundle *)bundleForView
@@ -80,356 +68,304 @@
     return formatter;
 }
 
-- (void)bind:(NSString *)expression toView:(UIView *)view withKeyPath:(NSString *)keyPath
+- (BOOL)coalescesBindingUpdates
 {
-    LMBinding *binding = [[LMBinding alloc] initWithExpression:expression view:view keyPath:keyPath];
-
-    [binding bindTo:self];
-
-    [[self bindings] addObject:binding];
+    return NO;
 }
 
-- (void)unbindAll
+- (BOOL)suspendsOffscreenBindings
 {
-    NSMutableArray *bindings = [self bindings];
-
-    for (LMBinding *binding in bindings) {
-        [binding unbindFrom:self];
-    }
-
-    [bindings removeAllObjects];
+    return NO;
 }
 
-- (NSMutableArray *)bindings
+- (BOOL)formatsBindingValuesAsynchronously
 {
-    NSMutableArray *bindings = objc_getAssociatedObject(self, @selector(bindings));
-
-    if (bindings == nil) {
-        bindings = [NSMutableArray new];
-
-        objc_setAssociatedObject(self, @selector(bindings), bindings, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
-    }
-
-    return bindings;
+    return NO;
 }
 
-@end
-
-@implementation LMBinding
++ (NSUInteger)bindingUpdateCount
 {
-    NSString *_formatterName;
-    NSDictionary *_formatterArguments;
+    return [LMBindingHub updateCount];
 }
 
-- (instancetype)initWithExpression:(NSString *)expression view:(UIView *)view keyPath:(NSString *)keyPath
++ (NSUInteger)coalescedBindingUpdateCount
 {
-    self = [super init];
-
-    if (self) {
-        NSArray *expressionComponents = [expression componentsSeparatedByString:@"::"];
-
-        _expression = [NSExpression expressionWithFormat:expressionComponents[0]];
-
-        if ([expressionComponents count] > 1) {
-            NSArray *formatComponents = [expressionComponents[1] componentsSeparatedByString:@";"];
-
-            _formatterName = [formatComponents[0] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
-
-            NSMutableDictionary *formatterArguments = [NSMutableDictionary new];
-
-            for (NSUInteger i = 1, n = [formatComponents count]; i < n; i++) {
-                NSArray *argumentComponents = [formatComponents[i] componentsSeparatedByString:@"="];
-
-                if ([argumentComponents count] > 1) {
-                    NSString *key = [argumentComponents[0] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
-                    NSString *value = [argumentComponents[1] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
-
-                    [formatterArguments setObject:value forKey:key];
-                }
-            }
-
-            _formatterArguments = formatterArguments;
-        }
-
-        _view = view;
-        _keyPath = keyPath;
-    }
-
-    return self;
+    return [LMBindingHub coalescedUpdateCount];
 }
 
-- (void)bindTo:(id)owner
++ (NSUInteger)suspendedBindingUpdateCount
 {
-    [self bindTo:owner expression:_expression];
+    return [LMBindingHub suspendedUpdateCount];
 }
 
-- (void)bindTo:(id)owner expression:(NSExpression *)expression
++ (NSUInteger)unchangedBindingValueCount
 {
-    switch ([expression expressionType]) {
-    case NSKeyPathExpressionType:
-        [owner addObserver:self forKeyPath:[expression keyPath] options:NSKeyValueObservingOptionInitial | NSKeyValueObservingOptionNew context:nil];
-
-        break;
-
-    case NSFunctionExpressionType:
-        for (NSExpression *argument in [expression arguments]) {
-            [self bindTo:owner expression:argument];
-        }
-
-        break;
-
-    default:
-        break;
-    }
+    return [LMBindingHub unchangedValueCount];
 }
 
-- (void)unbindFrom:(id)owner
+- (void)bind:(NSString *)expression toView:(UIView *)view withKeyPath:(NSString *)keyPath
 {
-    [self unbindFrom:owner expression:_expression];
+    [[self bindingHub] bind:expression toView:view withKeyPath:keyPath];
 }
 
-- (void)unbindFrom:(id)owner expression:(NSExpression *)expression
+- (void)rebind:(NSString *)key toSource:(id)source
 {
-    switch ([expression expressionType]) {
-    case NSKeyPathExpressionType:
-        [owner removeObserver:self forKeyPath:[expression keyPath] context:nil];
-
-        break;
+    [[self bindingHub] rebindKey:key toSource:source];
+}
 
-    case NSFunctionExpressionType:
-        for (NSExpression *argument in [expression arguments]) {
-            [self unbindFrom:owner expression:argument];
-        }
+- (void)unbindAll
+{
+    [[self bindingHub] removeAllBindings];
+}
 
-        break;
+- (NSUInteger)liveBindingCount
+{
+    LMBindingHub *bindingHub = [self bindingHub];
 
-    default:
-        break;
-    }
+    return [bindingHub bindingCount] - [bindingHub deadBindingCount];
 }
 
-- (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary *)change context:(void *)context
+- (NSUInteger)deadBindingCount
 {
-    id value = [_expression expressionValueWithObject:object context:nil];
+    return [[self bindingHub] deadBindingCount];
+}
 
-    if (value != nil && value != [NSNull null]) {
-        if (_formatterName != nil) {
-            NSFormatter *formatter = [object formatterWithName:_formatterName arguments:_formatterArguments];
+- (LMBindingHub *)bindingHub
+{
+    LMBindingHub *bindingHub = objc_getAssociatedObject(self, @selector(bindingHub));
 
-            if (formatter != nil) {
-                value = [formatter stringForObjectValue:value];
-            }
-        }
+    if (bindingHub == nil) {
+        bindingHub = [[LMBindingHub alloc] initWithOwner:self];
 
-        [_view setValue:value forKeyPath:_keyPath];
+        objc_setAssociatedObject(self, @selector(bindingHub), bindingHub, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
     }
+
+    return bindingHub;
 }
 
 @end
 
 @implementation UIGestureRecognizer (Markup)
 
-static NSDictionary *pressTypeValues;
-static NSDictionary *touchTypeValues;
+static const LMEnumEntry pressTypeEntries[] = {
+    {"upArrow", UIPressTypeUpArrow},
+    {"downArrow", UIPressTypeDownArrow},
+    {"leftArrow", UIPressTypeLeftArrow},
+    {"rightArrow", UIPressTypeRightArrow},
+    {"select", UIPressTypeSelect},
+    {"menu", UIPressTypeMenu},
+    {"playPause", UIPressTypePlayPause}
+};
 
-+ (void)initialize
-{
-    pressTypeValues = @{
-        @"upArrow": @(UIPressTypeUpArrow),
-        @"downArrow": @(UIPressTypeDownArrow),
-        @"leftArrow": @(UIPressTypeLeftArrow),
-        @"rightArrow": @(UIPressTypeRightArrow),
-        @"select": @(UIPressTypeSelect),
-        @"menu": @(UIPressTypeMenu),
-        @"playPause": @(UIPressTypePlayPause)
-    };
+static LMEnumTable pressTypeValues = LMEnumTableMake(pressTypeEntries);
 
-    touchTypeValues = @{
-        @"direct": @(UITouchTypeDirect),
-        @"indirect": @(UITouchTypeIndirect)
-    };
-}
+static const LMEnumEntry touchTypeEntries[] = {
+    {"direct", UITouchTypeDirect},
+    {"indirect", UITouchTypeIndirect}
+};
 
-- (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
+static LMEnumTable touchTypeValues = LMEnumTableMake(touchTypeEntries);
+
+static id LMAllowedPressTypesValue(id object, id value)
 {
-    if ([key isEqual:@"allowedPressTypes"]) {
-        NSArray *components = [value componentsSeparatedByString:@","];
+    NSArray *components = [value componentsSeparatedByString:@","];
 
-        NSMutableArray *allowedPressTypes = [[NSMutableArray alloc] initWithCapacity:[components count]];
+    NSMutableArray *allowedPressTypes = [[NSMutableArray alloc] initWithCapacity:[components count]];
 
-        for (NSString *component in components) {
-            [allowedPressTypes addObject:[pressTypeValues objectForKey:[component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]]]];
-        }
+    for (NSString *component in components) {
+        [allowedPressTypes addObject:LMEnumValue(&pressTypeValues, [component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]])];
+    }
 
-        value = allowedPressTypes;
-    } else if ([key isEqual:@"allowedTouchTypes"]) {
-        NSArray *components = [value componentsSeparatedByString:@","];
+    return allowedPressTypes;
+}
 
-        NSMutableArray *allowedTouchTypes = [[NSMutableArray alloc] initWithCapacity:[components count]];
+static id LMAllowedTouchTypesValue(id object, id value)
+{
+    NSArray *components = [value componentsSeparatedByString:@","];
 
-        for (NSString *component in components) {
-            [allowedTouchTypes addObject:[touchTypeValues objectForKey:[component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]]]];
-        }
+    NSMutableArray *allowedTouchTypes = [[NSMutableArray alloc] initWithCapacity:[components count]];
 
-        value = allowedTouchTypes;
+    for (NSString *component in components) {
+        [allowedTouchTypes addObject:LMEnumValue(&touchTypeValues, [component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]])];
     }
 
-    [super applyMarkupPropertyValue:value forKey:key];
+    return allowedTouchTypes;
+}
+
+static const LMPropertyConverter gestureRecognizerPropertyConverters[] = {
+    {"allowedPressTypes", NULL, LMAllowedPressTypesValue},
+    {"allowedTouchTypes", NULL, LMAllowedTouchTypesValue}
+};
+
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
+{
+    const LMPropertyConverter *converter = LMFindPropertyConverter(gestureRecognizerPropertyConverters,
+        LMPropertyConverterCount(gestureRecognizerPropertyConverters), key);
+
+    return (converter == NULL) ? [super propertyConverterForKey:key] : converter;
 }
 
 @end
 
 @implementation UIView (Markup)
 
-static NSDictionary *viewContentModeValues;
-static NSDictionary *viewTintAdjustmentModeValues;
-static NSDictionary *lineBreakModeValues;
-static NSDictionary *textAlignmentValues;
-static NSDictionary *textAutocapitalizationTypeValues;
-static NSDictionary *textAutocorrectionTypeValues;
-static NSDictionary *textSpellCheckingTypeValues;
-static NSDictionary *textSmartQuotesTypeValues;
-static NSDictionary *textSmartDashesTypeValues;
-static NSDictionary *textSmartInsertDeleteTypeValues;
-static NSDictionary *keyboardTypeValues;
-static NSDictionary *keyboardAppearanceValues;
-static NSDictionary *returnKeyTypeValues;
-static NSDictionary *barStyleValues;
-
-static NSDictionary *anchorValues;
-
-+ (void)initialize
-{
-    viewContentModeValues = @{
-        @"scaleToFill": @(UIViewContentModeScaleToFill),
-        @"scaleAspectFit": @(UIViewContentModeScaleAspectFit),
-        @"scaleAspectFill": @(UIViewContentModeScaleAspectFill),
-        @"redraw": @(UIViewContentModeRedraw),
-        @"center": @(UIViewContentModeCenter),
-        @"top": @(UIViewContentModeTop),
-        @"bottom": @(UIViewContentModeBottom),
-        @"left": @(UIViewContentModeLeft),
-        @"right": @(UIViewContentModeRight),
-        @"topLeft": @(UIViewContentModeTopLeft),
-        @"topRight": @(UIViewContentModeTopRight),
-        @"bottomLeft": @(UIViewContentModeBottomLeft),
-        @"bottomRight": @(UIViewContentModeBottomRight)
-    };
-
-    viewTintAdjustmentModeValues = @{
-        @"automatic": @(UIViewTintAdjustmentModeAutomatic),
-        @"normal": @(UIViewTintAdjustmentModeNormal),
-        @"dimmed": @(UIViewTintAdjustmentModeDimmed)
-    };
-
-    lineBreakModeValues = @{
-        @"byWordWrapping": @(NSLineBreakByWordWrapping),
-        @"byCharWrapping": @(NSLineBreakByCharWrapping),
-        @"byClipping": @(NSLineBreakByClipping),
-        @"byTruncatingHead": @(NSLineBreakByTruncatingHead),
-        @"byTruncatingTail": @(NSLineBreakByTruncatingTail),
-        @"byTruncatingMiddle": @(NSLineBreakByTruncatingMiddle)
-    };
-
-    textAlignmentValues = @{
-        @"left": @(NSTextAlignmentLeft),
-        @"center": @(NSTextAlignmentCenter),
-        @"right": @(NSTextAlignmentRight),
-        @"justified": @(NSTextAlignmentJustified),
-        @"natural": @(NSTextAlignmentNatural)
-    };
-
-    textAutocapitalizationTypeValues = @{
-        @"none": @(UITextAutocapitalizationTypeNone),
-        @"words": @(UITextAutocapitalizationTypeWords),
-        @"sentences": @(UITextAutocapitalizationTypeSentences),
-        @"allCharacters": @(UITextAutocapitalizationTypeAllCharacters)
-    };
-
-    textAutocorrectionTypeValues = @{
-        @"default": @(UITextAutocorrectionTypeDefault),
-        @"yes": @(UITextAutocorrectionTypeYes),
-        @"no": @(UITextAutocorrectionTypeNo)
-    };
-
-    textSpellCheckingTypeValues = @{
-        @"default": @(UITextSpellCheckingTypeDefault),
-        @"yes": @(UITextSpellCheckingTypeYes),
-        @"no": @(UITextSpellCheckingTypeNo)
-    };
-
-    if (@available(iOS 11, tvOS 11, *)) {
-        textSmartQuotesTypeValues = @{
-            @"default": @(UITextSmartQuotesTypeDefault),
-            @"no": @(UITextSmartQuotesTypeNo),
-            @"yes": @(UITextSmartQuotesTypeYes)
-        };
-
-        textSmartDashesTypeValues = @{
-            @"default": @(UITextSmartDashesTypeDefault),
-            @"no": @(UITextSmartDashesTypeNo),
-            @"yes": @(UITextSmartDashesTypeYes)
-        };
-
-        textSmartInsertDeleteTypeValues = @{
-            @"default": @(UITextSmartInsertDeleteTypeDefault),
-            @"no": @(UITextSmartInsertDeleteTypeNo),
-            @"yes": @(UITextSmartInsertDeleteTypeYes)
-        };
-    };
-
-    keyboardTypeValues = @{
-        @"default": @(UIKeyboardTypeDefault),
-        @"ASCIICapable": @(UIKeyboardTypeASCIICapable),
-        @"numbersAndPunctuation": @(UIKeyboardTypeNumbersAndPunctuation),
-        @"URL": @(UIKeyboardTypeURL),
-        @"numberPad": @(UIKeyboardTypeNumberPad),
-        @"phonePad": @(UIKeyboardTypePhonePad),
-        @"namePhonePad": @(UIKeyboardTypeNamePhonePad),
-        @"emailAddress": @(UIKeyboardTypeEmailAddress),
-        @"decimalPad": @(UIKeyboardTypeDecimalPad),
-        @"twitter": @(UIKeyboardTypeTwitter),
-        @"webSearch": @(UIKeyboardTypeWebSearch)
-    };
-
-    keyboardAppearanceValues = @{
-        @"default": @(UIKeyboardAppearanceDefault),
-        @"dark": @(UIKeyboardAppearanceDark),
-        @"light": @(UIKeyboardAppearanceLight)
-    };
-
-    returnKeyTypeValues = @{
-        @"default": @(UIReturnKeyDefault),
-        @"go": @(UIReturnKeyGo),
-        @"google": @(UIReturnKeyGoogle),
-        @"join": @(UIReturnKeyJoin),
-        @"next": @(UIReturnKeyNext),
-        @"route": @(UIReturnKeyRoute),
-        @"search": @(UIReturnKeySearch),
-        @"send": @(UIReturnKeySend),
-        @"yahoo": @(UIReturnKeyYahoo),
-        @"done": @(UIReturnKeyDone),
-        @"emergencyCall": @(UIReturnKeyEmergencyCall)
-    };
-
-    barStyleValues = @{
-        #if TARGET_OS_IOS
-        @"default": @(UIBarStyleDefault),
-        @"black": @(UIBarStyleBlack)
-        #endif
-    };
-
-    anchorValues = @{
-        @"none": @(LMAnchorNone),
-        @"top": @(LMAnchorTop),
-        @"bottom": @(LMAnchorBottom),
-        @"left": @(LMAnchorLeft),
-        @"right": @(LMAnchorRight),
-        @"leading": @(LMAnchorLeading),
-        @"trailing": @(LMAnchorTrailing),
-        @"all": @(LMAnchorAll)
-    };
-}
+static const LMEnumEntry viewContentModeEntries[] = {
+    {"scaleToFill", UIViewContentModeScaleToFill},
+    {"scaleAspectFit", UIViewContentModeScaleAspectFit},
+    {"scaleAspectFill", UIViewContentModeScaleAspectFill},
+    {"redraw", UIViewContentModeRedraw},
+    {"center", UIViewContentModeCenter},
+    {"top", UIViewContentModeTop},
+    {"bottom", UIViewContentModeBottom},
+    {"left", UIViewContentModeLeft},
+    {"right", UIViewContentModeRight},
+    {"topLeft", UIViewContentModeTopLeft},
+    {"topRight", UIViewContentModeTopRight},
+    {"bottomLeft", UIViewContentModeBottomLeft},
+    {"bottomRight", UIViewContentModeBottomRight}
+};
+
+static LMEnumTable viewContentModeValues = LMEnumTableMake(viewContentModeEntries);
+
+static const LMEnumEntry viewTintAdjustmentModeEntries[] = {
+    {"automatic", UIViewTintAdjustmentModeAutomatic},
+    {"normal", UIViewTintAdjustmentModeNormal},
+    {"dimmed", UIViewTintAdjustmentModeDimmed}
+};
+
+static LMEnumTable viewTintAdjustmentModeValues = LMEnumTableMake(viewTintAdjustmentModeEntries);
+
+static const LMEnumEntry lineBreakModeEntries[] = {
+    {"byWordWrapping", NSLineBreakByWordWrapping},
+    {"byCharWrapping", NSLineBreakByCharWrapping},
+    {"byClipping", NSLineBreakByClipping},
+    {"byTruncatingHead", NSLineBreakByTruncatingHead},
+    {"byTruncatingTail", NSLineBreakByTruncatingTail},
+    {"byTruncatingMiddle", NSLineBreakByTruncatingMiddle}
+};
+
+static LMEnumTable lineBreakModeValues = LMEnumTableMake(lineBreakModeEntries);
+
+static const LMEnumEntry textAlignmentEntries[] = {
+    {"left", NSTextAlignmentLeft},
+    {"center", NSTextAlignmentCenter},
+    {"right", NSTextAlignmentRight},
+    {"justified", NSTextAlignmentJustified},
+    {"natural", NSTextAlignmentNatural}
+};
+
+static LMEnumTable textAlignmentValues = LMEnumTableMake(textAlignmentEntries);
+
+static const LMEnumEntry textAutocapitalizationTypeEntries[] = {
+    {"none", UITextAutocapitalizationTypeNone},
+    {"words", UITextAutocapitalizationTypeWords},
+    {"sentences", UITextAutocapitalizationTypeSentences},
+    {"allCharacters", UITextAutocapitalizationTypeAllCharacters}
+};
+
+static LMEnumTable textAutocapitalizationTypeValues = LMEnumTableMake(textAutocapitalizationTypeEntries);
+
+static const LMEnumEntry textAutocorrectionTypeEntries[] = {
+    {"default", UITextAutocorrectionTypeDefault},
+    {"yes", UITextAutocorrectionTypeYes},
+    {"no", UITextAutocorrectionTypeNo}
+};
+
+static LMEnumTable textAutocorrectionTypeValues = LMEnumTableMake(textAutocorrectionTypeEntries);
+
+static const LMEnumEntry textSpellCheckingTypeEntries[] = {
+    {"default", UITextSpellCheckingTypeDefault},
+    {"yes", UITextSpellCheckingTypeYes},
+    {"no", UITextSpellCheckingTypeNo}
+};
+
+static LMEnumTable textSpellCheckingTypeValues = LMEnumTableMake(textSpellCheckingTypeEntries);
+
+static const LMEnumEntry textSmartQuotesTypeEntries[] API_AVAILABLE(ios(11.0), tvos(11.0)) = {
+    {"default", UITextSmartQuotesTypeDefault},
+    {"no", UITextSmartQuotesTypeNo},
+    {"yes", UITextSmartQuotesTypeYes}
+};
+
+static LMEnumTable textSmartQuotesTypeValues API_AVAILABLE(ios(11.0), tvos(11.0)) = LMEnumTableMake(textSmartQuotesTypeEntries);
+
+static const LMEnumEntry textSmartDashesTypeEntries[] API_AVAILABLE(ios(11.0), tvos(11.0)) = {
+    {"default", UITextSmartDashesTypeDefault},
+    {"no", UITextSmartDashesTypeNo},
+    {"yes", UITextSmartDashesTypeYes}
+};
+
+static LMEnumTable textSmartDashesTypeValues API_AVAILABLE(ios(11.0), tvos(11.0)) = LMEnumTableMake(textSmartDashesTypeEntries);
+
+static const LMEnumEntry textSmartInsertDeleteTypeEntries[] API_AVAILABLE(ios(11.0), tvos(11.0)) = {
+    {"default", UITextSmartInsertDeleteTypeDefault},
+    {"no", UITextSmartInsertDeleteTypeNo},
+    {"yes", UITextSmartInsertDeleteTypeYes}
+};
+
+static LMEnumTable textSmartInsertDeleteTypeValues API_AVAILABLE(ios(11.0), tvos(11.0)) = LMEnumTableMake(textSmartInsertDeleteTypeEntries);
+
+static const LMEnumEntry keyboardTypeEntries[] = {
+    {"default", UIKeyboardTypeDefault},
+    {"ASCIICapable", UIKeyboardTypeASCIICapable},
+    {"numbersAndPunctuation", UIKeyboardTypeNumbersAndPunctuation},
+    {"URL", UIKeyboardTypeURL},
+    {"numberPad", UIKeyboardTypeNumberPad},
+    {"phonePad", UIKeyboardTypePhonePad},
+    {"namePhonePad", UIKeyboardTypeNamePhonePad},
+    {"emailAddress", UIKeyboardTypeEmailAddress},
+    {"decimalPad", UIKeyboardTypeDecimalPad},
+    {"twitter", UIKeyboardTypeTwitter},
+    {"webSearch", UIKeyboardTypeWebSearch}
+};
+
+static LMEnumTable keyboardTypeValues = LMEnumTableMake(keyboardTypeEntries);
+
+static const LMEnumEntry keyboardAppearanceEntries[] = {
+    {"default", UIKeyboardAppearanceDefault},
+    {"dark", UIKeyboardAppearanceDark},
+    {"light", UIKeyboardAppearanceLight}
+};
+
+static LMEnumTable keyboardAppearanceValues = LMEnumTableMake(keyboardAppearanceEntries);
+
+static const LMEnumEntry returnKeyTypeEntries[] = {
+    {"default", UIReturnKeyDefault},
+    {"go", UIReturnKeyGo},
+    {"google", UIReturnKeyGoogle},
+    {"join", UIReturnKeyJoin},
+    {"next", UIReturnKeyNext},
+    {"route", UIReturnKeyRoute},
+    {"search", UIReturnKeySearch},
+    {"send", UIReturnKeySend},
+    {"yahoo", UIReturnKeyYahoo},
+    {"done", UIReturnKeyDone},
+    {"emergencyCall", UIReturnKeyEmergencyCall}
+};
+
+static LMEnumTable returnKeyTypeValues = LMEnumTableMake(returnKeyTypeEntries);
+
+#if TARGET_OS_IOS
+static const LMEnumEntry barStyleEntries[] = {
+    {"default", UIBarStyleDefault},
+    {"black", UIBarStyleBlack}
+};
+
+static LMEnumTable barStyleValues = LMEnumTableMake(barStyleEntries);
+#endif
+
+static const LMEnumEntry anchorEntries[] = {
+    {"none", LMAnchorNone},
+    {"top", LMAnchorTop},
+    {"bottom", LMAnchorBottom},
+    {"left", LMAnchorLeft},
+    {"right", LMAnchorRight},
+    {"leading", LMAnchorLeading},
+    {"trailing", LMAnchorTrailing},
+    {"all", LMAnchorAll}
+};
+
+static LMEnumTable anchorValues = LMEnumTableMake(anchorEntries);
 
 - (CGFloat)minimumWidth
 {
@@ -751,116 +687,179 @@ static NSDictionary *anchorValues;
     [[self superview] setNeedsUpdateConstraints];
 }
 
-- (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
+// Text input traits are set directly rather than through KVC
+static id LMApplyAutocapitalizationType(id object, id value)
 {
-    if ([key isEqual:@"contentMode"]) {
-        value = [viewContentModeValues objectForKey:value];
-    } else if ([key isEqual:@"tintAdjustmentMode"]) {
-        value = [viewTintAdjustmentModeValues objectForKey:value];
-    } else if ([key isEqual:@"lineBreakMode"]) {
-        value = [lineBreakModeValues objectForKey:value];
-    } else if ([key isEqual:@"textAlignment"]) {
-        value = [textAlignmentValues objectForKey:value];
-    } else if ([key isEqual:@"autocapitalizationType"]) {
-        value = [textAutocapitalizationTypeValues objectForKey:value];
+    value = LMEnumValue(&textAutocapitalizationTypeValues, value);
 
-        if (value != nil) {
-            [(UIView<UITextInputTraits> *)self setAutocapitalizationType:[value integerValue]];
-        }
+    if (value != nil) {
+        [(UIView<UITextInputTraits> *)object setAutocapitalizationType:[value integerValue]];
+    }
 
-        return;
-    } else if ([key isEqual:@"autocorrectionType"]) {
-        value = [textAutocorrectionTypeValues objectForKey:value];
+    return nil;
+}
 
-        if (value != nil) {
-            [(UIView<UITextInputTraits> *)self setAutocorrectionType:[value integerValue]];
-        }
+static id LMApplyAutocorrectionType(id object, id value)
+{
+    value = LMEnumValue(&textAutocorrectionTypeValues, value);
 
-        return;
-    } else if ([key isEqual:@"spellCheckingType"]) {
-        value = [textSpellCheckingTypeValues objectForKey:value];
+    if (value != nil) {
+        [(UIView<UITextInputTraits> *)object setAutocorrectionType:[value integerValue]];
+    }
 
-        if (value != nil) {
-            [(UIView<UITextInputTraits> *)self setSpellCheckingType:[value integerValue]];
-        }
+    return nil;
+}
 
-        return;
-    } else if ([key isEqual:@"smartQuotesType"]) {
-        value = [textSmartQuotesTypeValues objectForKey:value];
+static id LMApplySpellCheckingType(id object, id value)
+{
+    value = LMEnumValue(&textSpellCheckingTypeValues, value);
 
-        if (value != nil) {
-            if (@available(iOS 11, tvOS 11, *)) {
-                [(UIView<UITextInputTraits> *)self setSmartQuotesType:[value integerValue]];
-            }
-        }
+    if (value != nil) {
+        [(UIView<UITextInputTraits> *)object setSpellCheckingType:[value integerValue]];
+    }
 
-        return;
-    } else if ([key isEqual:@"smartDashesType"]) {
-        value = [textSmartDashesTypeValues objectForKey:value];
+    return nil;
+}
+
+static id LMApplySmartQuotesType(id object, id value)
+{
+    if (@available(iOS 11, tvOS 11, *)) {
+        value = LMEnumValue(&textSmartQuotesTypeValues, value);
 
         if (value != nil) {
-            if (@available(iOS 11, tvOS 11, *)) {
-                [(UIView<UITextInputTraits> *)self setSmartDashesType:[value integerValue]];
-            }
+            [(UIView<UITextInputTraits> *)object setSmartQuotesType:[value integerValue]];
         }
+    }
 
-        return;
-    } else if ([key isEqual:@"smartInsertDeleteType"]) {
-        value = [textSmartInsertDeleteTypeValues objectForKey:value];
+    return nil;
+}
+
+static id LMApplySmartDashesType(id object, id value)
+{
+    if (@available(iOS 11, tvOS 11, *)) {
+        value = LMEnumValue(&textSmartDashesTypeValues, value);
 
         if (value != nil) {
-            if (@available(iOS 11, tvOS 11, *)) {
-                [(UIView<UITextInputTraits> *)self setSmartInsertDeleteType:[value integerValue]];
-            }
+            [(UIView<UITextInputTraits> *)object setSmartDashesType:[value integerValue]];
         }
+    }
+
+    return nil;
+}
 
-        return;
-    } else if ([key isEqual:@"keyboardType"]) {
-        value = [keyboardTypeValues objectForKey:value];
+static id LMApplySmartInsertDeleteType(id object, id value)
+{
+    if (@available(iOS 11, tvOS 11, *)) {
+        value = LMEnumValue(&textSmartInsertDeleteTypeValues, value);
 
         if (value != nil) {
-            [(UIView<UITextInputTraits> *)self setKeyboardType:[value integerValue]];
+            [(UIView<UITextInputTraits> *)object setSmartInsertDeleteType:[value integerValue]];
         }
+    }
 
-        return;
-    } else if ([key isEqual:@"keyboardAppearance"]) {
-        value = [keyboardAppearanceValues objectForKey:value];
+    return nil;
+}
 
-        if (value != nil) {
-            [(UIView<UITextInputTraits> *)self setKeyboardAppearance:[value integerValue]];
-        }
+static id LMApplyKeyboardType(id object, id value)
+{
+    value = LMEnumValue(&keyboardTypeValues, value);
 
-        return;
-    } else if ([key isEqual:@"returnKeyType"]) {
-        value = [returnKeyTypeValues objectForKey:value];
+    if (value != nil) {
+        [(UIView<UITextInputTraits> *)object setKeyboardType:[value integerValue]];
+    }
 
-        if (value != nil) {
-            [(UIView<UITextInputTraits> *)self setReturnKeyType:[value integerValue]];
-        }
+    return nil;
+}
 
-        return;
-    } else if ([key isEqual:@"barStyle"]) {
-        value = [barStyleValues objectForKey:value];
-    } else if ([key isEqual:@"layoutMargins"] || [key rangeOfString:@"^.*Insets?$"
-        options:NSRegularExpressionSearch].location != NSNotFound) {
-        CGFloat inset = [value floatValue];
+static id LMApplyKeyboardAppearance(id object, id value)
+{
+    value = LMEnumValue(&keyboardAppearanceValues, value);
 
-        value = [NSValue valueWithUIEdgeInsets:UIEdgeInsetsMake(inset, inset, inset, inset)];
-    } else if ([key isEqual:@"anchor"]) {
-        NSArray *components = [value componentsSeparatedByString:@","];
+    if (value != nil) {
+        [(UIView<UITextInputTraits> *)object setKeyboardAppearance:[value integerValue]];
+    }
 
-        LMAnchor anchor = LMAnchorNone;
+    return nil;
+}
 
-        for (NSString *component in components) {
-            NSString *name = [component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+static id LMApplyReturnKeyType(id object, id value)
+{
+    value = LMEnumValue(&returnKeyTypeValues, value);
 
-            anchor |= [[anchorValues objectForKey:name] unsignedIntegerValue];
-        }
+    if (value != nil) {
+        [(UIView<UITextInputTraits> *)object setReturnKeyType:[value integerValue]];
+    }
+
+    return nil;
+}
+
+static id LMBarStyleValue(id object, id value)
+{
+    #if TARGET_OS_IOS
+    return LMEnumValue(&barStyleValues, value);
+    #else
+    return nil;
+    #endif
+}
 
-        value = @(anchor);
+static id LMEdgeInsetsValue(id object, id value)
+{
+    CGFloat inset = [value floatValue];
+
+    return [NSValue valueWithUIEdgeInsets:UIEdgeInsetsMake(inset, inset, inset, inset)];
+}
+
+static id LMAnchorValue(id object, id value)
+{
+    NSArray *components = [value componentsSeparatedByString:@","];
+
+    LMAnchor anchor = LMAnchorNone;
+
+    for (NSString *component in components) {
+        NSString *name = [component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+
+        anchor |= [LMEnumValue(&anchorValues, name) unsignedIntegerValue];
     }
 
-    [super applyMarkupPropertyValue:value forKey:key];
+    return @(anchor);
+}
+
+static const LMPropertyConverter viewPropertyConverters[] = {
+    {"contentMode", &viewContentModeValues, NULL},
+    {"tintAdjustmentMode", &viewTintAdjustmentModeValues, NULL},
+    {"lineBreakMode", &lineBreakModeValues, NULL},
+    {"textAlignment", &textAlignmentValues, NULL},
+    {"autocapitalizationType", NULL, LMApplyAutocapitalizationType},
+    {"autocorrectionType", NULL, LMApplyAutocorrectionType},
+    {"spellCheckingType", NULL, LMApplySpellCheckingType},
+    {"smartQuotesType", NULL, LMApplySmartQuotesType},
+    {"smartDashesType", NULL, LMApplySmartDashesType},
+    {"smartInsertDeleteType", NULL, LMApplySmartInsertDeleteType},
+    {"keyboardType", NULL, LMApplyKeyboardType},
+    {"keyboardAppearance", NULL, LMApplyKeyboardAppearance},
+    {"returnKeyType", NULL, LMApplyReturnKeyType},
+    {"barStyle", NULL, LMBarStyleValue},
+    {"layoutMargins", NULL, LMEdgeInsetsValue},
+    {"anchor", NULL, LMAnchorValue}
+};
+
+static const LMPropertyConverter viewEdgeInsetsPropertyConverter = {"", NULL, LMEdgeInsetsValue};
+
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
+{
+    const LMPropertyConverter *converter = LMFindPropertyConverter(viewPropertyConverters,
+        LMPropertyConverterCount(viewPropertyConverters), key);
+
+    if (converter == NULL && ([key hasSuffix:@"Inset"] || [key hasSuffix:@"Insets"])) {
+        converter = &viewEdgeInsetsPropertyConverter;
+    }
+
+    return (converter == NULL) ? [super propertyConverterForKey:key] : converter;
+}
+
+- (BOOL)writesUnchangedBindingValueForKeyPath:(NSString *)keyPath
+{
+    return NO;
 }
 
 - (void)processMarkupInstruction:(NSString *)target data:(NSString *)data
@@ -919,35 +918,35 @@ static NSDictionary *anchorValues;
 
 @implementation UIControl (Markup)
 
-static NSDictionary *controlContentHorizontalAlignmentValues;
-static NSDictionary *controlContentVerticalAlignmentValues;
+static const LMEnumEntry controlContentHorizontalAlignmentEntries[] = {
+    {"center", UIControlContentHorizontalAlignmentCenter},
+    {"left", UIControlContentHorizontalAlignmentLeft},
+    {"right", UIControlContentHorizontalAlignmentRight},
+    {"fill", UIControlContentHorizontalAlignmentFill}
+};
 
-+ (void)initialize
-{
-    controlContentHorizontalAlignmentValues = @{
-        @"center": @(UIControlContentHorizontalAlignmentCenter),
-        @"left": @(UIControlContentHorizontalAlignmentLeft),
-        @"right": @(UIControlContentHorizontalAlignmentRight),
-        @"fill": @(UIControlContentHorizontalAlignmentFill)
-    };
+static LMEnumTable controlContentHorizontalAlignmentValues = LMEnumTableMake(controlContentHorizontalAlignmentEntries);
 
-    controlContentVerticalAlignmentValues = @{
-        @"center": @(UIControlContentVerticalAlignmentCenter),
-        @"top": @(UIControlContentVerticalAlignmentTop),
-        @"bottom": @(UIControlContentVerticalAlignmentBottom),
-        @"fill": @(UIControlContentVerticalAlignmentFill)
-    };
-}
+static const LMEnumEntry controlContentVerticalAlignmentEntries[] = {
+    {"center", UIControlContentVerticalAlignmentCenter},
+    {"top", UIControlContentVerticalAlignmentTop},
+    {"bottom", UIControlContentVerticalAlignmentBottom},
+    {"fill", UIControlContentVerticalAlignmentFill}
+};
 
-- (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
+static LMEnumTable controlContentVerticalAlignmentValues = LMEnumTableMake(controlContentVerticalAlignmentEntries);
+
+static const LMPropertyConverter controlPropertyConverters[] = {
+    {"contentHorizontalAlignment", &controlContentHorizontalAlignmentValues, NULL},
+    {"contentVerticalAlignment", &controlContentVerticalAlignmentValues, NULL}
+};
+
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
 {
-    if ([key isEqual:@"contentHorizontalAlignment"]) {
-        value = [controlContentHorizontalAlignmentValues objectForKey:value];
-    } else if ([key isEqual:@"contentVerticalAlignment"]) {
-        value = [controlContentVerticalAlignmentValues objectForKey:value];
-    }
+    const LMPropertyConverter *converter = LMFindPropertyConverter(controlPropertyConverters,
+        LMPropertyConverterCount(controlPropertyConverters), key);
 
-    [super applyMarkupPropertyValue:value forKey:key];
+    return (converter == NULL) ? [super propertyConverterForKey:key] : converter;
 }
 
 @end
@@ -1252,25 +1251,31 @@ static NSDictionary *controlContentVerticalAlignmentValues;
 
 @implementation UIDatePicker (Markup)
 
-static NSDictionary *datePickerModeValues;
+static const LMEnumEntry datePickerModeEntries[] = {
+    {"time", UIDatePickerModeTime},
+    {"date", UIDatePickerModeDate},
+    {"dateAndTime", UIDatePickerModeDateAndTime},
+    {"countDownTimer", UIDatePickerModeCountDownTimer}
+};
+
+static LMEnumTable datePickerModeValues = LMEnumTableMake(datePickerModeEntries);
 
-+ (void)initialize
+static const LMPropertyConverter datePickerPropertyConverters[] = {
+    {"datePickerMode", &datePickerModeValues, NULL}
+};
+
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
 {
-    datePickerModeValues = @{
-        @"time": @(UIDatePickerModeTime),
-        @"date": @(UIDatePickerModeDate),
-        @"dateAndTime": @(UIDatePickerModeDateAndTime),
-        @"countDownTimer": @(UIDatePickerModeCountDownTimer)
-    };
+    const LMPropertyConverter *converter = LMFindPropertyConverter(datePickerPropertyConverters,
+        LMPropertyConverterCount(datePickerPropertyConverters), key);
+
+    return (converter == NULL) ? [super propertyConverterForKey:key] : converter;
 }
 
-- (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
+- (BOOL)writesUnchangedBindingValueForKeyPath:(NSString *)keyPath
 {
-    if ([key isEqual:@"datePickerMode"]) {
-        value = [datePickerModeValues objectForKey:value];
-    }
-
-    [super applyMarkupPropertyValue:value forKey:key];
+    // The date may have been changed by the user since it was last bound
+    return [keyPath isEqual:@"date"] || [super writesUnchangedBindingValueForKeyPath:keyPath];
 }
 
 @end
@@ -1299,6 +1304,13 @@ static NSString * const kSegmentValueKey = @"value";
     return (index == -1) ? nil : [self valueForSegmentAtIndex:index];
 }
 
+- (BOOL)writesUnchangedBindingValueForKeyPath:(NSString *)keyPath
+{
+    // The selection may have been changed by the user since it was last bound
+    return [keyPath isEqual:@"selectedSegmentIndex"] || [keyPath isEqual:@"value"]
+        || [super writesUnchangedBindingValueForKeyPath:keyPath];
+}
+
 - (void)setValue:(id)value
 {
     NSInteger index = -1;
@@ -1357,35 +1369,44 @@ typedef enum {
 static NSString * const kLeftViewTarget = @"leftView";
 static NSString * const kRightViewTarget = @"rightView";
 
-static NSDictionary *textBorderStyleValues;
-static NSDictionary *textFieldViewModeValues;
+static const LMEnumEntry textBorderStyleEntries[] = {
+    {"none", UITextBorderStyleNone},
+    {"line", UITextBorderStyleLine},
+    {"bezel", UITextBorderStyleBezel},
+    {"roundedRect", UITextBorderStyleRoundedRect}
+};
+
+static LMEnumTable textBorderStyleValues = LMEnumTableMake(textBorderStyleEntries);
+
+static const LMEnumEntry textFieldViewModeEntries[] = {
+    {"never", UITextFieldViewModeNever},
+    {"whileEditing", UITextFieldViewModeWhileEditing},
+    {"unlessEditing", UITextFieldViewModeUnlessEditing},
+    {"always", UITextFieldViewModeAlways}
+};
+
+static LMEnumTable textFieldViewModeValues = LMEnumTableMake(textFieldViewModeEntries);
+
+static const LMPropertyConverter textFieldPropertyConverters[] = {
+    {"borderStyle", &textBorderStyleValues, NULL},
+    {"clearButtonMode", &textFieldViewModeValues, NULL},
+    {"leftViewMode", &textFieldViewModeValues, NULL},
+    {"rightViewMode", &textFieldViewModeValues, NULL}
+};
 
-+ (void)initialize
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
 {
-    textBorderStyleValues = @{
-        @"none": @(UITextBorderStyleNone),
-        @"line": @(UITextBorderStyleLine),
-        @"bezel": @(UITextBorderStyleBezel),
-        @"roundedRect": @(UITextBorderStyleRoundedRect)
-    };
+    const LMPropertyConverter *converter = LMFindPropertyConverter(textFieldPropertyConverters,
+        LMPropertyConverterCount(textFieldPropertyConverters), key);
 
-    textFieldViewModeValues = @{
-        @"never": @(UITextFieldViewModeNever),
-        @"whileEditing": @(UITextFieldViewModeWhileEditing),
-        @"unlessEditing": @(UITextFieldViewModeUnlessEditing),
-        @"always": @(UITextFieldViewModeAlways)
-    };
+    return (converter == NULL) ? [super propertyConverterForKey:key] : converter;
 }
 
-- (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
+- (BOOL)writesUnchangedBindingValueForKeyPath:(NSString *)keyPath
 {
-    if ([key isEqual:@"borderStyle"]) {
-        value = [textBorderStyleValues objectForKey:value];
-    } else if ([key isEqual:@"clearButtonMode"] || [key isEqual:@"leftViewMode"] || [key isEqual:@"rightViewMode"]) {
-        value = [textFieldViewModeValues objectForKey:value];
-    }
-
-    [super applyMarkupPropertyValue:value forKey:key];
+    // The text may have been edited by the user since it was last bound
+    return [keyPath isEqual:@"text"] || [keyPath isEqual:@"attributedText"]
+        || [super writesUnchangedBindingValueForKeyPath:keyPath];
 }
 
 - (void)processMarkupInstruction:(NSString *)target data:(NSString *)data
@@ -1439,28 +1460,71 @@ static NSDictionary *textFieldViewModeValues;
 
 @end
 
-@implementation UIActivityIndicatorView (Markup)
+@implementation UITextView (Markup)
+
+- (BOOL)writesUnchangedBindingValueForKeyPath:(NSString *)keyPath
+{
+    // The text may have been edited by the user since it was last bound
+    return [keyPath isEqual:@"text"] || [keyPath isEqual:@"attributedText"]
+        || [super writesUnchangedBindingValueForKeyPath:keyPath];
+}
+
+@end
 
-static NSDictionary *activityIndicatorViewStyleValues;
+#if TARGET_OS_IOS
+@implementation UISwitch (Markup)
 
-+ (void)initialize
+- (BOOL)writesUnchangedBindingValueForKeyPath:(NSString *)keyPath
 {
-    activityIndicatorViewStyleValues = @{
-        @"whiteLarge": @(UIActivityIndicatorViewStyleWhiteLarge),
-        @"white": @(UIActivityIndicatorViewStyleWhite),
-        #if TARGET_OS_IOS
-        @"gray": @(UIActivityIndicatorViewStyleGray)
-        #endif
-    };
+    // The state may have been changed by the user since it was last bound
+    return [keyPath isEqual:@"on"] || [super writesUnchangedBindingValueForKeyPath:keyPath];
 }
 
-- (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
+@end
+
+@implementation UISlider (Markup)
+
+- (BOOL)writesUnchangedBindingValueForKeyPath:(NSString *)keyPath
 {
-    if ([key isEqual:@"activityIndicatorViewStyle"]) {
-        value = [activityIndicatorViewStyleValues objectForKey:value];
-    }
+    // The value may have been changed by the user since it was last bound
+    return [keyPath isEqual:@"value"] || [super writesUnchangedBindingValueForKeyPath:keyPath];
+}
+
+@end
 
-    [super applyMarkupPropertyValue:value forKey:key];
+@implementation UIStepper (Markup)
+
+- (BOOL)writesUnchangedBindingValueForKeyPath:(NSString *)keyPath
+{
+    // The value may have been changed by the user since it was last bound
+    return [keyPath isEqual:@"value"] || [super writesUnchangedBindingValueForKeyPath:keyPath];
+}
+
+@end
+#endif
+
+@implementation UIActivityIndicatorView (Markup)
+
+static const LMEnumEntry activityIndicatorViewStyleEntries[] = {
+    {"whiteLarge", UIActivityIndicatorViewStyleWhiteLarge},
+    {"white", UIActivityIndicatorViewStyleWhite},
+    #if TARGET_OS_IOS
+    {"gray", UIActivityIndicatorViewStyleGray}
+    #endif
+};
+
+static LMEnumTable activityIndicatorViewStyleValues = LMEnumTableMake(activityIndicatorViewStyleEntries);
+
+static const LMPropertyConverter activityIndicatorViewPropertyConverters[] = {
+    {"activityIndicatorViewStyle", &activityIndicatorViewStyleValues, NULL}
+};
+
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
+{
+    const LMPropertyConverter *converter = LMFindPropertyConverter(activityIndicatorViewPropertyConverters,
+        LMPropertyConverterCount(activityIndicatorViewPropertyConverters), key);
+
+    return (converter == NULL) ? [super propertyConverterForKey:key] : converter;
 }
 
 @end
@@ -1653,24 +1717,24 @@ static NSString * const kOverlayContentTarget = @"overlayContent";
 
 @implementation UISearchBar (Markup)
 
-static NSDictionary *searchBarStyleValues;
+static const LMEnumEntry searchBarStyleEntries[] = {
+    {"default", UISearchBarStyleDefault},
+    {"prominent", UISearchBarStyleProminent},
+    {"minimal", UISearchBarStyleMinimal}
+};
 
-+ (void)initialize
-{
-    searchBarStyleValues = @{
-        @"default": @(UISearchBarStyleDefault),
-        @"prominent": @(UISearchBarStyleProminent),
-        @"minimal": @(UISearchBarStyleMinimal)
-    };
-}
+static LMEnumTable searchBarStyleValues = LMEnumTableMake(searchBarStyleEntries);
+
+static const LMPropertyConverter searchBarPropertyConverters[] = {
+    {"searchBarStyle", &searchBarStyleValues, NULL}
+};
 
-- (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
 {
-    if ([key isEqual:@"searchBarStyle"]) {
-        value = [searchBarStyleValues objectForKey:value];
-    }
+    const LMPropertyConverter *converter = LMFindPropertyConverter(searchBarPropertyConverters,
+        LMPropertyConverterCount(searchBarPropertyConverters), key);
 
-    [super applyMarkupPropertyValue:value forKey:key];
+    return (converter == NULL) ? [super propertyConverterForKey:key] : converter;
 }
 
 @end
@@ -1683,33 +1747,30 @@ typedef enum {
 
 static NSString * const kRefreshControlTarget = @"refreshControl";
 
-static NSDictionary *scrollViewIndicatorStyleValues;
-static NSDictionary *scrollViewKeyboardDismissModeValues;
-static NSDictionary *scrollViewContentInsetAdjustmentBehaviorValues;
+static const LMEnumEntry scrollViewIndicatorStyleEntries[] = {
+    {"default", UIScrollViewIndicatorStyleDefault},
+    {"black", UIScrollViewIndicatorStyleBlack},
+    {"white", UIScrollViewIndicatorStyleWhite}
+};
 
-+ (void)initialize
-{
-    scrollViewIndicatorStyleValues = @{
-        @"default": @(UIScrollViewIndicatorStyleDefault),
-        @"black": @(UIScrollViewIndicatorStyleBlack),
-        @"white": @(UIScrollViewIndicatorStyleWhite)
-    };
+static LMEnumTable scrollViewIndicatorStyleValues = LMEnumTableMake(scrollViewIndicatorStyleEntries);
 
-    scrollViewKeyboardDismissModeValues = @{
-        @"none": @(UIScrollViewKeyboardDismissModeNone),
-        @"onDrag": @(UIScrollViewKeyboardDismissModeOnDrag),
-        @"interactive": @(UIScrollViewKeyboardDismissModeInteractive)
-    };
+static const LMEnumEntry scrollViewKeyboardDismissModeEntries[] = {
+    {"none", UIScrollViewKeyboardDismissModeNone},
+    {"onDrag", UIScrollViewKeyboardDismissModeOnDrag},
+    {"interactive", UIScrollViewKeyboardDismissModeInteractive}
+};
 
-    if (@available(iOS 11, tvOS 11, *)) {
-        scrollViewContentInsetAdjustmentBehaviorValues = @{
-            @"automatic": @(UIScrollViewContentInsetAdjustmentAutomatic),
-            @"scrollableAxes": @(UIScrollViewContentInsetAdjustmentScrollableAxes),
-            @"never": @(UIScrollViewContentInsetAdjustmentNever),
-            @"always": @(UIScrollViewContentInsetAdjustmentAlways)
-        };
-    }
-}
+static LMEnumTable scrollViewKeyboardDismissModeValues = LMEnumTableMake(scrollViewKeyboardDismissModeEntries);
+
+static const LMEnumEntry scrollViewContentInsetAdjustmentBehaviorEntries[] API_AVAILABLE(ios(11.0), tvos(11.0)) = {
+    {"automatic", UIScrollViewContentInsetAdjustmentAutomatic},
+    {"scrollableAxes", UIScrollViewContentInsetAdjustmentScrollableAxes},
+    {"never", UIScrollViewContentInsetAdjustmentNever},
+    {"always", UIScrollViewContentInsetAdjustmentAlways}
+};
+
+static LMEnumTable scrollViewContentInsetAdjustmentBehaviorValues API_AVAILABLE(ios(11.0), tvos(11.0)) = LMEnumTableMake(scrollViewContentInsetAdjustmentBehaviorEntries);
 
 - (CGFloat)contentInsetTop
 {
@@ -1782,17 +1843,27 @@ static NSDictionary *scrollViewContentInsetAdjustmentBehaviorValues;
     [self setContentOffset:CGPointMake([self bounds].size.width * currentPage, 0) animated:animated];
 }
 
-- (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
+static id LMContentInsetAdjustmentBehaviorValue(id object, id value)
 {
-    if ([key isEqual:@"indicatorStyle"]) {
-        value = [scrollViewIndicatorStyleValues objectForKey:value];
-    } else if ([key isEqual:@"keyboardDismissMode"]) {
-        value = [scrollViewKeyboardDismissModeValues objectForKey:value];
-    } else if ([key isEqual:@"contentInsetAdjustmentBehavior"]) {
-        value = [scrollViewContentInsetAdjustmentBehaviorValues objectForKey:value];
+    if (@available(iOS 11, tvOS 11, *)) {
+        return LMEnumValue(&scrollViewContentInsetAdjustmentBehaviorValues, value);
+    } else {
+        return nil;
     }
+}
 
-    [super applyMarkupPropertyValue:value forKey:key];
+static const LMPropertyConverter scrollViewPropertyConverters[] = {
+    {"indicatorStyle", &scrollViewIndicatorStyleValues, NULL},
+    {"keyboardDismissMode", &scrollViewKeyboardDismissModeValues, NULL},
+    {"contentInsetAdjustmentBehavior", NULL, LMContentInsetAdjustmentBehaviorValue}
+};
+
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
+{
+    const LMPropertyConverter *converter = LMFindPropertyConverter(scrollViewPropertyConverters,
+        LMPropertyConverterCount(scrollViewPropertyConverters), key);
+
+    return (converter == NULL) ? [super propertyConverterForKey:key] : converter;
 }
 
 - (void)processMarkupInstruction:(NSString *)target data:(NSString *)data
@@ -1838,26 +1909,22 @@ static NSDictionary *scrollViewContentInsetAdjustmentBehaviorValues;
 
 @implementation UITableView (Markup)
 
-static NSDictionary *tableViewCellSeparatorStyleValues;
-static NSDictionary *tableViewSeparatorInsetReferenceValues;
+#if TARGET_OS_IOS
+static const LMEnumEntry tableViewCellSeparatorStyleEntries[] = {
+    {"none", UITableViewCellSeparatorStyleNone},
+    {"singleLine", UITableViewCellSeparatorStyleSingleLine},
+    {"singleLineEtched", UITableViewCellSeparatorStyleSingleLineEtched}
+};
 
-+ (void)initialize
-{
-    tableViewCellSeparatorStyleValues = @{
-        #if TARGET_OS_IOS
-        @"none": @(UITableViewCellSeparatorStyleNone),
-        @"singleLine": @(UITableViewCellSeparatorStyleSingleLine),
-        @"singleLineEtched": @(UITableViewCellSeparatorStyleSingleLineEtched)
-        #endif
-    };
+static LMEnumTable tableViewCellSeparatorStyleValues = LMEnumTableMake(tableViewCellSeparatorStyleEntries);
+#endif
 
-    if (@available(iOS 11, tvOS 11, *)) {
-        tableViewSeparatorInsetReferenceValues = @{
-            @"fromCellEdges": @(UITableViewSeparatorInsetFromCellEdges),
-            @"fromAutomaticInsets": @(UITableViewSeparatorInsetFromAutomaticInsets)
-        };
-    }
-}
+static const LMEnumEntry tableViewSeparatorInsetReferenceEntries[] API_AVAILABLE(ios(11.0), tvos(11.0)) = {
+    {"fromCellEdges", UITableViewSeparatorInsetFromCellEdges},
+    {"fromAutomaticInsets", UITableViewSeparatorInsetFromAutomaticInsets}
+};
+
+static LMEnumTable tableViewSeparatorInsetReferenceValues API_AVAILABLE(ios(11.0), tvos(11.0)) = LMEnumTableMake(tableViewSeparatorInsetReferenceEntries);
 
 - (NSString *)nameForSection:(NSInteger)section
 {
@@ -1909,43 +1976,61 @@ static NSDictionary *tableViewSeparatorInsetReferenceValues;
     return nil;
 }
 
-- (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
+static id LMSeparatorStyleValue(id object, id value)
+{
+    #if TARGET_OS_IOS
+    return LMEnumValue(&tableViewCellSeparatorStyleValues, value);
+    #else
+    return nil;
+    #endif
+}
+
+static id LMSeparatorInsetReferenceValue(id object, id value)
 {
-    if ([key isEqual:@"separatorStyle"]) {
-        value = [tableViewCellSeparatorStyleValues objectForKey:value];
-    } else if ([key isEqual:@"separatorInsetReference"]) {
-        value = [tableViewSeparatorInsetReferenceValues objectForKey:value];
+    if (@available(iOS 11, tvOS 11, *)) {
+        return LMEnumValue(&tableViewSeparatorInsetReferenceValues, value);
+    } else {
+        return nil;
     }
+}
 
-    [super applyMarkupPropertyValue:value forKey:key];
+static const LMPropertyConverter tableViewPropertyConverters[] = {
+    {"separatorStyle", NULL, LMSeparatorStyleValue},
+    {"separatorInsetReference", NULL, LMSeparatorInsetReferenceValue}
+};
+
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
+{
+    const LMPropertyConverter *converter = LMFindPropertyConverter(tableViewPropertyConverters,
+        LMPropertyConverterCount(tableViewPropertyConverters), key);
+
+    return (converter == NULL) ? [super propertyConverterForKey:key] : converter;
 }
 
 @end
 
 @implementation UITableViewCell (Markup)
 
-static NSDictionary *tableViewCellAccessoryTypeValues;
-static NSDictionary *tableViewCellSelectionStyleValues;
+static const LMEnumEntry tableViewCellAccessoryTypeEntries[] = {
+    {"none", UITableViewCellAccessoryNone},
+    {"disclosureIndicator", UITableViewCellAccessoryDisclosureIndicator},
+    #if TARGET_OS_IOS
+    {"detailDisclosureButton", UITableViewCellAccessoryDetailDisclosureButton},
+    #endif
+    {"checkmark", UITableViewCellAccessoryCheckmark},
+    #if TARGET_OS_IOS
+    {"detailButton", UITableViewCellAccessoryDetailButton}
+    #endif
+};
 
-+ (void)initialize
-{
-    tableViewCellAccessoryTypeValues = @{
-        @"none": @(UITableViewCellAccessoryNone),
-        @"disclosureIndicator": @(UITableViewCellAccessoryDisclosureIndicator),
-        #if TARGET_OS_IOS
-        @"detailDisclosureButton": @(UITableViewCellAccessoryDetailDisclosureButton),
-        #endif
-        @"checkmark": @(UITableViewCellAccessoryCheckmark),
-        #if TARGET_OS_IOS
-        @"detailButton": @(UITableViewCellAccessoryDetailButton)
-        #endif
-    };
+static LMEnumTable tableViewCellAccessoryTypeValues = LMEnumTableMake(tableViewCellAccessoryTypeEntries);
 
-    tableViewCellSelectionStyleValues = @{
-        @"none": @(UITableViewCellSelectionStyleNone),
-        @"default": @(UITableViewCellSelectionStyleDefault)
-    };
-}
+static const LMEnumEntry tableViewCellSelectionStyleEntries[] = {
+    {"none", UITableViewCellSelectionStyleNone},
+    {"default", UITableViewCellSelectionStyleDefault}
+};
+
+static LMEnumTable tableViewCellSelectionStyleValues = LMEnumTableMake(tableViewCellSelectionStyleEntries);
 
 + (UITableViewCell *)defaultTableViewCell
 {
@@ -1987,15 +2072,17 @@ static NSDictionary *tableViewCellSelectionStyleValues;
     [self setAccessoryType:checked ? UITableViewCellAccessoryCheckmark : UITableViewCellAccessoryNone];
 }
 
-- (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
+static const LMPropertyConverter tableViewCellPropertyConverters[] = {
+    {"accessoryType", &tableViewCellAccessoryTypeValues, NULL},
+    {"selectionStyle", &tableViewCellSelectionStyleValues, NULL}
+};
+
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
 {
-    if ([key isEqual:@"accessoryType"]) {
-        value = [tableViewCellAccessoryTypeValues objectForKey:value];
-    } else if ([key isEqual:@"selectionStyle"]) {
-        value = [tableViewCellSelectionStyleValues objectForKey:value];
-    }
+    const LMPropertyConverter *converter = LMFindPropertyConverter(tableViewCellPropertyConverters,
+        LMPropertyConverterCount(tableViewCellPropertyConverters), key);
 
-    [super applyMarkupPropertyValue:value forKey:key];
+    return (converter == NULL) ? [super propertyConverterForKey:key] : converter;
 }
 
 - (void)appendMarkupElementView:(UIView *)view
@@ -2009,24 +2096,20 @@ static NSDictionary *tableViewCellSelectionStyleValues;
 
 @implementation UICollectionViewFlowLayout (Markup)
 
-static NSDictionary *collectionViewScrollDirectionValues;
-static NSDictionary *collectionViewFlowLayoutSectionInsetReferenceValues;
+static const LMEnumEntry collectionViewScrollDirectionEntries[] = {
+    {"vertical", UICollectionViewScrollDirectionVertical},
+    {"horizontal", UICollectionViewScrollDirectionHorizontal}
+};
 
-+ (void)initialize
-{
-    collectionViewScrollDirectionValues = @{
-        @"vertical": @(UICollectionViewScrollDirectionVertical),
-        @"horizontal": @(UICollectionViewScrollDirectionHorizontal)
-    };
+static LMEnumTable collectionViewScrollDirectionValues = LMEnumTableMake(collectionViewScrollDirectionEntries);
 
-    if (@available(iOS 11, tvOS 11, *)) {
-        collectionViewFlowLayoutSectionInsetReferenceValues = @{
-            @"fromContentInset": @(UICollectionViewFlowLayoutSectionInsetFromContentInset),
-            @"fromSafeArea": @(UICollectionViewFlowLayoutSectionInsetFromSafeArea),
-            @"fromLayoutMargins": @(UICollectionViewFlowLayoutSectionInsetFromLayoutMargins)
-        };
-    }
-}
+static const LMEnumEntry collectionViewFlowLayoutSectionInsetReferenceEntries[] API_AVAILABLE(ios(11.0), tvos(11.0)) = {
+    {"fromContentInset", UICollectionViewFlowLayoutSectionInsetFromContentInset},
+    {"fromSafeArea", UICollectionViewFlowLayoutSectionInsetFromSafeArea},
+    {"fromLayoutMargins", UICollectionViewFlowLayoutSectionInsetFromLayoutMargins}
+};
+
+static LMEnumTable collectionViewFlowLayoutSectionInsetReferenceValues API_AVAILABLE(ios(11.0), tvos(11.0)) = LMEnumTableMake(collectionViewFlowLayoutSectionInsetReferenceEntries);
 
 - (CGFloat)itemWidth
 {
@@ -2164,19 +2247,27 @@ static NSDictionary *collectionViewFlowLayoutSectionInsetReferenceValues;
     [self setFooterReferenceSize:CGSizeMake([self footerReferenceSize].width, footerReferenceHeight)];
 }
 
-- (void)applyMarkupPropertyValue:(id)value forKey:(NSString *)key
+static id LMSectionInsetReferenceValue(id object, id value)
 {
-    if ([key isEqual:@"scrollDirection"]) {
-        value = [collectionViewScrollDirectionValues objectForKey:value];
-    } else if ([key isEqual:@"sectionInset"]) {
-        CGFloat inset = [value floatValue];
-
-        value = [NSValue valueWithUIEdgeInsets:UIEdgeInsetsMake(inset, inset, inset, inset)];
-    } else if ([key isEqual:@"sectionInsetReference"]) {
-        value = [collectionViewFlowLayoutSectionInsetReferenceValues objectForKey:value];
+    if (@available(iOS 11, tvOS 11, *)) {
+        return LMEnumValue(&collectionViewFlowLayoutSectionInsetReferenceValues, value);
+    } else {
+        return nil;
     }
+}
+
+static const LMPropertyConverter collectionViewFlowLayoutPropertyConverters[] = {
+    {"scrollDirection", &collectionViewScrollDirectionValues, NULL},
+    {"sectionInset", NULL, LMEdgeInsetsValue},
+    {"sectionInsetReference", NULL, LMSectionInsetReferenceValue}
+};
+
++ (const LMPropertyConverter *)propertyConverterForKey:(NSString *)key
+{
+    const LMPropertyConverter *converter = LMFindPropertyConverter(collectionViewFlowLayoutPropertyConverters,
+        LMPropertyConverterCount(collectionViewFlowLayoutPropertyConverters), key);
 
-    [super applyMarkupPropertyValue:value forKey:key];
+    return (converter == NULL) ? [super propertyConverterForKey:key] : converter;
 }
 
 @end
@@ -0,0 +1,304 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Compares strategies for classifying the attributes of the documents named on the
+// command line as properties, factories, templates, outlets, or actions, mirroring
+// LMViewBuilder:
+//
+//   chain   compares each key against every reserved name in turn and then checks
+//           the value's prefixes, for every attribute of every element on every load
+//   table   looks each key up in a perfect hash table, for every attribute
+//   indexed classifies each distinct key and value string once per document, after
+//           which every attribute is classified by string index, as LMViewDocument does
+//
+// Event values are those of UIControlEvents.
+
+#include "LMTest.h"
+#include "LMMarkupCompiler.h"
+#include "LMEnumTable.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum {
+    LMAttributeProperty = 0,
+    LMAttributeFactory,
+    LMAttributeTemplate,
+    LMAttributeOutlet,
+    LMAttributeAction,
+    LMAttributeBinding,
+    LMAttributeLocalizedString,
+    LMAttributeEscaped
+} LMAttributeType;
+
+// Entry values hold the attribute type in the low byte and the control event above it
+#define LMAction(event) (((long)(event) << 8) | LMAttributeAction)
+
+static const LMEnumEntry attributeEntries[] = {
+    {"style", LMAttributeFactory},
+    {"class", LMAttributeTemplate},
+    {"id", LMAttributeOutlet},
+    {"onTouchDown", LMAction(1 << 0)},
+    {"onTouchDownRepeat", LMAction(1 << 1)},
+    {"onTouchDragInside", LMAction(1 << 2)},
+    {"onTouchDragOutside", LMAction(1 << 3)},
+    {"onTouchDragEnter", LMAction(1 << 4)},
+    {"onTouchDragExit", LMAction(1 << 5)},
+    {"onTouchUpInside", LMAction(1 << 6)},
+    {"onTouchUpOutside", LMAction(1 << 7)},
+    {"onTouchCancel", LMAction(1 << 8)},
+    {"onValueChanged", LMAction(1 << 12)},
+    {"onPrimaryActionTriggered", LMAction(1 << 13)},
+    {"onEditingDidBegin", LMAction(1 << 16)},
+    {"onEditingChanged", LMAction(1 << 17)},
+    {"onEditingDidEnd", LMAction(1 << 18)},
+    {"onEditingDidEndOnExit", LMAction(1 << 19)},
+    {"onAllTouchEvents", LMAction(0x00000FFF)},
+    {"onAllEditingEvents", LMAction(0x000F0000)},
+    {"onAllEvents", LMAction(0xFFFFFFFF)}
+};
+
+static LMEnumTable attributeTable = LMEnumTableMake(attributeEntries);
+
+static const double kDuration = 0.5;
+
+static long classifyValue(const char *value)
+{
+    switch (value[0]) {
+        case '$': {
+            return LMAttributeBinding;
+        }
+
+        case '@': {
+            return LMAttributeLocalizedString;
+        }
+
+        case '^': {
+            return LMAttributeEscaped;
+        }
+
+        default: {
+            return LMAttributeProperty;
+        }
+    }
+}
+
+static long classifyByChain(const char *key, const char *value)
+{
+    for (size_t i = 0; i < sizeof(attributeEntries) / sizeof(*attributeEntries); i++) {
+        if (strcmp(key, attributeEntries[i].name) == 0) {
+            return attributeEntries[i].value;
+        }
+    }
+
+    if (strncmp(value, "$", 1) == 0) {
+        return LMAttributeBinding;
+    } else if (strncmp(value, "@", 1) == 0) {
+        return LMAttributeLocalizedString;
+    } else if (strncmp(value, "^", 1) == 0) {
+        return LMAttributeEscaped;
+    }
+
+    return LMAttributeProperty;
+}
+
+static long classifyByTable(const char *key, size_t keyLength, const char *value)
+{
+    long type;
+
+    if (LMEnumTableLookup(&attributeTable, key, keyLength, &type)) {
+        return type;
+    }
+
+    return classifyValue(value);
+}
+
+static long *classifyStrings(LMMarkupDocumentRef document)
+{
+    // Key classifications occupy the low half of each entry and value classifications
+    // the high half, since the same string may be used as both
+    uint32_t count = LMMarkupDocumentGetStringCount(document);
+
+    long *types = calloc(count == 0 ? 1 : count, sizeof(long));
+
+    for (uint32_t i = 0; i < count; i++) {
+        size_t length;
+        const char *string = LMMarkupDocumentGetString(document, i, &length);
+
+        long type;
+
+        if (!LMEnumTableLookup(&attributeTable, string, length, &type)) {
+            type = LMAttributeProperty;
+        }
+
+        types[i] = type | (classifyValue(string) << 56);
+    }
+
+    return types;
+}
+
+static long classifyByIndex(const long *types, const LMMarkupAttribute *attribute)
+{
+    long type = types[attribute->key] & 0x00FFFFFFFFFFFFFF;
+
+    return (type != LMAttributeProperty) ? type : (types[attribute->value] >> 56);
+}
+
+int main(int argc, char *argv[])
+{
+    int count = argc - 1;
+
+    LMMarkupDocumentRef *documents = calloc(count, sizeof(LMMarkupDocumentRef));
+    long **types = calloc(count, sizeof(long *));
+
+    uint64_t attributes = 0;
+
+    for (int i = 0; i < count; i++) {
+        size_t length;
+        char *bytes = LMTestReadFile(argv[i + 1], &length);
+
+        LMAssert(bytes != NULL);
+
+        if (bytes == NULL) {
+            return LMTestFinish("LMAttributeBenchmark");
+        }
+
+        LMMarkupError error;
+        uint32_t line, column;
+
+        documents[i] = LMMarkupCompile(bytes, length, &error, &line, &column);
+
+        free(bytes);
+
+        LMAssert(documents[i] != NULL);
+
+        if (documents[i] == NULL) {
+            return LMTestFinish("LMAttributeBenchmark");
+        }
+
+        types[i] = classifyStrings(documents[i]);
+
+        // Every strategy must agree
+        for (uint32_t j = 0, n = LMMarkupDocumentGetNodeCount(documents[i]); j < n; j++) {
+            const LMMarkupNode *node = LMMarkupDocumentGetNode(documents[i], j);
+
+            if (node->type != LMMarkupNodeStartElement) {
+                continue;
+            }
+
+            for (uint32_t k = 0; k < node->count; k++) {
+                const LMMarkupAttribute *attribute = LMMarkupDocumentGetAttribute(documents[i], node->first + k);
+
+                size_t keyLength;
+                const char *key = LMMarkupDocumentGetString(documents[i], attribute->key, &keyLength);
+                const char *value = LMMarkupDocumentGetString(documents[i], attribute->value, NULL);
+
+                long type = classifyByChain(key, value);
+
+                LMAssert(classifyByTable(key, keyLength, value) == type);
+                LMAssert(classifyByIndex(types[i], attribute) == type);
+
+                attributes++;
+            }
+        }
+    }
+
+    printf("%d documents, %llu attributes\n", count, (unsigned long long)attributes);
+
+    for (int strategy = 0; strategy < 3; strategy++) {
+        uint64_t passes = 0, sum = 0;
+
+        double start = LMTestNow(), elapsed;
+
+        do {
+            for (int i = 0; i < count; i++) {
+                LMMarkupDocumentRef document = documents[i];
+
+                for (uint32_t j = 0, n = LMMarkupDocumentGetNodeCount(document); j < n; j++) {
+                    const LMMarkupNode *node = LMMarkupDocumentGetNode(document, j);
+
+                    if (node->type != LMMarkupNodeStartElement) {
+                        continue;
+                    }
+
+                    for (uint32_t k = 0; k < node->count; k++) {
+                        const LMMarkupAttribute *attribute = LMMarkupDocumentGetAttribute(document, node->first + k);
+
+                        switch (strategy) {
+                            case 0: {
+                                sum += classifyByChain(LMMarkupDocumentGetString(document, attribute->key, NULL),
+                                    LMMarkupDocumentGetString(document, attribute->value, NULL));
+
+                                break;
+                            }
+
+                            case 1: {
+                                size_t keyLength;
+                                const char *key = LMMarkupDocumentGetString(document, attribute->key, &keyLength);
+
+                                sum += classifyByTable(key, keyLength, LMMarkupDocumentGetString(document, attribute->value, NULL));
+
+                                break;
+                            }
+
+                            default: {
+                                sum += classifyByIndex(types[i], attribute);
+
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+
+            passes++;
+        } while ((elapsed = LMTestNow() - start) < kDuration);
+
+        LMTestConsume(sum);
+
+        static const char *names[] = {"chain", "table", "indexed"};
+
+        printf("%-8s %8.2f ns/attribute\n", names[strategy], elapsed * 1e9 / (passes * attributes));
+    }
+
+    // The one-time cost of classifying a document's strings, amortized over its attributes
+    uint64_t passes = 0;
+
+    double start = LMTestNow(), elapsed;
+
+    do {
+        for (int i = 0; i < count; i++) {
+            long *documentTypes = classifyStrings(documents[i]);
+
+            LMTestConsume((uint64_t)documentTypes[0]);
+
+            free(documentTypes);
+        }
+
+        passes++;
+    } while ((elapsed = LMTestNow() - start) < kDuration);
+
+    printf("%-8s %8.2f ns/attribute (once per document load)\n", "classify", elapsed * 1e9 / (passes * attributes));
+
+    for (int i = 0; i < count; i++) {
+        free(types[i]);
+
+        LMMarkupDocumentRelease(documents[i]);
+    }
+
+    free(types);
+    free(documents);
+
+    return LMTestFinish("LMAttributeBenchmark");
+}
@@ -0,0 +1,164 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Compares the evaluation rate of compiled binding expressions with that of the
+// equivalent NSExpression (or, for comparisons, NSPredicate), and checks that both
+// produce the same results. Requires macOS.
+
+#import "LMBindingExpression.h"
+
+#include "LMTest.h"
+
+@interface LMBenchmarkModel : NSObject
+
+@property (nonatomic) NSInteger quantity;
+@property (nonatomic) double price;
+@property (nonatomic) double discount;
+@property (nonatomic) NSInteger limit;
+
+@property (nonatomic) NSString *name;
+@property (nonatomic) BOOL enabled;
+@property (nonatomic) NSDecimalNumber *balance;
+
+@property (nonatomic, nullable) LMBenchmarkModel *child;
+
+- (NSString *)labelForValue:(NSNumber *)value;
+
+@end
+
+@implementation LMBenchmarkModel
+
+- (NSString *)labelForValue:(NSNumber *)value
+{
+    return [value stringValue];
+}
+
+@end
+
+static const double kDuration = 0.25;
+
+static double measure(id (^evaluate)(void), id *result)
+{
+    NSUInteger count = 0;
+
+    double start = LMTestNow(), elapsed;
+
+    do {
+        @autoreleasepool {
+            for (NSUInteger i = 0; i < 1000; i++) {
+                *result = evaluate();
+            }
+        }
+
+        count += 1000;
+    } while ((elapsed = LMTestNow() - start) < kDuration);
+
+    return count / elapsed;
+}
+
+int main(int argc, char *argv[])
+{
+    @autoreleasepool {
+        LMBenchmarkModel *model = [LMBenchmarkModel new];
+
+        [model setQuantity:12];
+        [model setPrice:2.5];
+        [model setDiscount:0.75];
+        [model setLimit:20];
+
+        // A string built at run time has a different concrete class than a literal
+        [model setName:[NSMutableString stringWithFormat:@"%@", @"Apple"]];
+        [model setEnabled:YES];
+        [model setBalance:[NSDecimalNumber decimalNumberWithString:@"12.50"]];
+
+        LMBenchmarkModel *child = [LMBenchmarkModel new];
+
+        [child setQuantity:3];
+        [child setPrice:1.25];
+
+        [model setChild:child];
+
+        // Comparisons are predicates rather than expressions in Foundation
+        NSArray<NSString *> *expressions = @[
+            @"quantity",
+            @"child.quantity",
+            @"quantity * price",
+            @"(quantity + 1) * price - discount",
+            @"quantity * 2 - limit",
+            @"child.quantity + child.price",
+            @"sum:(quantity, price, discount)",
+            @"max:(quantity, limit)",
+            @"average:(quantity, price)",
+            @"FUNCTION(SELF, 'labelForValue:', quantity)",
+            @"9223372036854775808 + quantity",
+            @"-(quantity - quantity - 9223372036854775807 - 1)"
+        ];
+
+        NSArray<NSString *> *predicates = @[
+            @"quantity > 10",
+            @"quantity * 2 >= limit",
+            @"child.price < price",
+            @"name < 'M'",
+            @"name >= 'Apple'",
+            @"enabled >= 1",
+            @"enabled == YES",
+            @"balance > 10",
+            @"balance <= quantity"
+        ];
+
+        printf("%-44s %8s %14s %14s %8s\n", "expression", "compiled", "evals/s", "Foundation/s", "speedup");
+
+        for (NSString *string in [expressions arrayByAddingObjectsFromArray:predicates]) {
+            BOOL isPredicate = [predicates containsObject:string];
+
+            LMBindingExpression *bindingExpression = [[LMBindingExpression alloc] initWithString:string];
+
+            id (^baseline)(void);
+
+            if (isPredicate) {
+                NSPredicate *predicate = [NSPredicate predicateWithFormat:string];
+
+                baseline = ^id {
+                    return @([predicate evaluateWithObject:model]);
+                };
+            } else {
+                NSExpression *expression = [NSExpression expressionWithFormat:string];
+
+                baseline = ^id {
+                    return [expression expressionValueWithObject:model context:nil];
+                };
+            }
+
+            id result = nil;
+            id baselineResult = nil;
+
+            double rate = measure(^id {
+                return [bindingExpression evaluateWithObject:model];
+            }, &result);
+
+            double baselineRate = measure(baseline, &baselineResult);
+
+            if (![result isEqual:baselineResult]) {
+                fprintf(stderr, "%s: %s != %s\n", [string UTF8String], [[result description] UTF8String], [[baselineResult description] UTF8String]);
+
+                LMTestFailures++;
+            }
+
+            printf("%-44s %8s %14.0f %14.0f %7.1fx\n", [string UTF8String], [bindingExpression isCompiled] ? "yes" : "no",
+                rate, baselineRate, rate / baselineRate);
+        }
+    }
+
+    return LMTestFinish("LMBindingExpressionBenchmark");
+}
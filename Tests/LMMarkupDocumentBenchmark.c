@@ -0,0 +1,127 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Compares the cost of compiling the markup documents named on the command line with
+// the cost of decoding their compiled form, which is what a bundled .mkb file saves.
+
+#include "LMTest.h"
+#include "LMMarkupCompiler.h"
+
+#include <stdlib.h>
+
+typedef struct {
+    char *markup;
+    size_t markupLength;
+
+    void *encoded;
+    size_t encodedLength;
+} LMBenchmarkDocument;
+
+static const double kDuration = 0.5;
+
+int main(int argc, char *argv[])
+{
+    int count = argc - 1;
+
+    LMBenchmarkDocument *documents = calloc(count, sizeof(LMBenchmarkDocument));
+
+    size_t markupLength = 0;
+    size_t encodedLength = 0;
+
+    for (int i = 0; i < count; i++) {
+        LMBenchmarkDocument *document = &documents[i];
+
+        document->markup = LMTestReadFile(argv[i + 1], &document->markupLength);
+
+        LMAssert(document->markup != NULL);
+
+        if (document->markup == NULL) {
+            return LMTestFinish("LMMarkupDocumentBenchmark");
+        }
+
+        LMMarkupError error;
+        uint32_t line, column;
+
+        LMMarkupDocumentRef markupDocument = LMMarkupCompile(document->markup, document->markupLength, &error, &line, &column);
+
+        LMAssert(markupDocument != NULL);
+
+        if (markupDocument == NULL) {
+            return LMTestFinish("LMMarkupDocumentBenchmark");
+        }
+
+        document->encoded = LMMarkupDocumentEncode(markupDocument, &document->encodedLength);
+
+        LMMarkupDocumentRelease(markupDocument);
+
+        markupLength += document->markupLength;
+        encodedLength += document->encodedLength;
+    }
+
+    printf("%d documents, %zu bytes of markup, %zu bytes compiled\n", count, markupLength, encodedLength);
+
+    // Compile
+    uint64_t passes = 0;
+
+    double start = LMTestNow(), elapsed;
+
+    do {
+        for (int i = 0; i < count; i++) {
+            LMMarkupError error;
+            uint32_t line, column;
+
+            LMMarkupDocumentRef markupDocument = LMMarkupCompile(documents[i].markup, documents[i].markupLength, &error, &line, &column);
+
+            LMTestConsume(LMMarkupDocumentGetNodeCount(markupDocument));
+
+            LMMarkupDocumentRelease(markupDocument);
+        }
+
+        passes++;
+    } while ((elapsed = LMTestNow() - start) < kDuration);
+
+    printf("compile: %10.0f documents/s %8.1f MB/s\n", passes * count / elapsed, passes * markupLength / elapsed / 1e6);
+
+    double compileTime = elapsed / (passes * count);
+
+    // Decode
+    passes = 0;
+
+    start = LMTestNow();
+
+    do {
+        for (int i = 0; i < count; i++) {
+            LMMarkupDocumentRef markupDocument = LMMarkupDocumentDecode(documents[i].encoded, documents[i].encodedLength);
+
+            LMTestConsume(LMMarkupDocumentMatchesSource(markupDocument, documents[i].markup, documents[i].markupLength));
+
+            LMMarkupDocumentRelease(markupDocument);
+        }
+
+        passes++;
+    } while ((elapsed = LMTestNow() - start) < kDuration);
+
+    printf("decode:  %10.0f documents/s %8.1f MB/s (including the staleness check)\n", passes * count / elapsed, passes * encodedLength / elapsed / 1e6);
+
+    printf("decoding is %.1fx faster than compiling\n", compileTime / (elapsed / (passes * count)));
+
+    for (int i = 0; i < count; i++) {
+        free(documents[i].markup);
+        free(documents[i].encoded);
+    }
+
+    free(documents);
+
+    return LMTestFinish("LMMarkupDocumentBenchmark");
+}
@@ -0,0 +1,245 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Compiles each markup document named on the command line, and verifies that the
+// encoded form round-trips and is tied to its source.
+
+#include "LMTest.h"
+#include "LMMarkupCompiler.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static LMMarkupDocumentRef compile(const char *markup)
+{
+    LMMarkupError error;
+    uint32_t line, column;
+
+    return LMMarkupCompile(markup, strlen(markup), &error, &line, &column);
+}
+
+static bool stringEquals(LMMarkupDocumentRef document, uint32_t index, const char *string)
+{
+    size_t length;
+    const char *bytes = LMMarkupDocumentGetString(document, index, &length);
+
+    return bytes != NULL && length == strlen(string) && memcmp(bytes, string, length) == 0;
+}
+
+static void testRoundTrip(const char *path)
+{
+    size_t length;
+    char *bytes = LMTestReadFile(path, &length);
+
+    LMAssert(bytes != NULL);
+
+    if (bytes == NULL) {
+        return;
+    }
+
+    LMMarkupError error;
+    uint32_t line, column;
+
+    LMMarkupDocumentRef document = LMMarkupCompile(bytes, length, &error, &line, &column);
+
+    if (document == NULL) {
+        fprintf(stderr, "%s:%u:%u: error %d\n", path, line, column, error);
+    }
+
+    LMAssert(document != NULL);
+    LMAssert(error == LMMarkupErrorNone);
+
+    if (document != NULL) {
+        size_t encodedLength;
+        void *encoded = LMMarkupDocumentEncode(document, &encodedLength);
+
+        LMAssert(encoded != NULL);
+
+        LMMarkupDocumentRef decoded = LMMarkupDocumentDecode(encoded, encodedLength);
+
+        LMAssert(decoded != NULL);
+
+        if (decoded != NULL) {
+            LMAssert(LMMarkupDocumentGetNodeCount(decoded) == LMMarkupDocumentGetNodeCount(document));
+            LMAssert(LMMarkupDocumentGetStringCount(decoded) == LMMarkupDocumentGetStringCount(document));
+
+            // Re-encoding a decoded document reproduces it exactly
+            size_t reencodedLength;
+            void *reencoded = LMMarkupDocumentEncode(decoded, &reencodedLength);
+
+            LMAssert(reencoded != NULL && reencodedLength == encodedLength && memcmp(reencoded, encoded, encodedLength) == 0);
+
+            free(reencoded);
+
+            // The decoded document matches its source, but not an edited copy of it
+            LMAssert(LMMarkupDocumentMatchesSource(decoded, bytes, length));
+            LMAssert(!LMMarkupDocumentMatchesSource(decoded, bytes, length - 1));
+
+            if (length > 0) {
+                bytes[length / 2] ^= 1;
+
+                LMAssert(!LMMarkupDocumentMatchesSource(decoded, bytes, length));
+
+                bytes[length / 2] ^= 1;
+            }
+
+            LMMarkupDocumentRelease(decoded);
+        }
+
+        // Truncated documents are rejected
+        for (size_t i = 0; i < encodedLength; i += (i < 64) ? 1 : 61) {
+            LMMarkupDocumentRef truncated = LMMarkupDocumentDecode(encoded, i);
+
+            LMAssert(truncated == NULL);
+
+            LMMarkupDocumentRelease(truncated);
+        }
+
+        free(encoded);
+
+        LMMarkupDocumentRelease(document);
+    }
+
+    free(bytes);
+}
+
+static void testUnknownSource(void)
+{
+    LMMarkupDocumentRef document = LMMarkupDocumentCreate();
+
+    size_t length;
+    void *encoded = LMMarkupDocumentEncode(document, &length);
+
+    LMMarkupDocumentRelease(document);
+
+    LMMarkupDocumentRef decoded = LMMarkupDocumentDecode(encoded, length);
+
+    LMAssert(decoded != NULL);
+
+    // Documents that were not compiled from markup are never considered stale
+    if (decoded != NULL) {
+        LMAssert(LMMarkupDocumentMatchesSource(decoded, "<a/>", 4));
+    }
+
+    LMMarkupDocumentRelease(decoded);
+
+    free(encoded);
+}
+
+static void testProperties(void)
+{
+    LMMarkupDocumentRef document = compile("<?properties {\n"
+        "    \"label\": {\"text\": \"caf\\u00e9 \\ud83d\\ude00\", \"width\": 120, \"alpha\": 0.5,\n"
+        "        \"hidden\": false, \"tag\": -9223372036854775808, \"large\": 9223372036854775808,\n"
+        "        \"scale\": 1e2, \"tint\": null},\n"
+        "    \"empty\": {}\n"
+        "}?>\n"
+        "<root/>\n");
+
+    LMAssert(document != NULL);
+
+    if (document == NULL) {
+        return;
+    }
+
+    const LMMarkupNode *node = LMMarkupDocumentGetNode(document, 0);
+
+    LMAssert(node->type == LMMarkupNodeProperties);
+    LMAssert(node->count == 2);
+
+    const LMMarkupTemplate *template = LMMarkupDocumentGetTemplate(document, node->first);
+
+    LMAssert(stringEquals(document, template->name, "label"));
+    LMAssert(template->count == 8);
+
+    const LMMarkupProperty *properties = LMMarkupDocumentGetProperty(document, template->first);
+
+    LMAssert(stringEquals(document, properties[0].key, "text"));
+    LMAssert(properties[0].type == LMMarkupValueString);
+    LMAssert(stringEquals(document, properties[0].string, "caf\xC3\xA9 \xF0\x9F\x98\x80"));
+
+    LMAssert(properties[1].type == LMMarkupValueInteger && properties[1].integer == 120);
+    LMAssert(properties[2].type == LMMarkupValueNumber && properties[2].number == 0.5);
+    LMAssert(properties[3].type == LMMarkupValueBoolean && properties[3].number == 0);
+    LMAssert(properties[4].type == LMMarkupValueInteger && properties[4].integer == INT64_MIN);
+    LMAssert(properties[5].type == LMMarkupValueNumber && properties[5].number == 9223372036854775808.0);
+    LMAssert(properties[6].type == LMMarkupValueNumber && properties[6].number == 100);
+    LMAssert(properties[7].type == LMMarkupValueNull);
+
+    template = LMMarkupDocumentGetTemplate(document, node->first + 1);
+
+    LMAssert(stringEquals(document, template->name, "empty"));
+    LMAssert(template->count == 0);
+
+    LMMarkupDocumentRelease(document);
+}
+
+static void testUnsupportedProperties(void)
+{
+    // Markup the compiler can't represent is kept as an instruction for the builder to interpret
+    static const char *markup[] = {
+        "<?properties {\"a\": {\"x\": 1, \"x\": 2}}?><root/>",
+        "<?properties {\"a\": {}, \"a\": {}}?><root/>",
+        "<?properties {\"a\": {\"x\": [1]}}?><root/>",
+        "<?properties {\"a\": {\"x\": 01}}?><root/>",
+        "<?properties {\"a\": {\"x\": \"\\ud800\"}}?><root/>",
+        "<?properties {\"a\": {\"x\": \"\\u0000\"}}?><root/>",
+        "<?properties {\"a\": {\"x\": 1},}?><root/>",
+        "<?properties {\"a\": 1}?><root/>",
+        "<?properties Templates.json?><root/>"
+    };
+
+    for (size_t i = 0; i < sizeof(markup) / sizeof(*markup); i++) {
+        LMMarkupDocumentRef document = compile(markup[i]);
+
+        LMAssert(document != NULL);
+
+        if (document != NULL) {
+            const LMMarkupNode *node = LMMarkupDocumentGetNode(document, 0);
+
+            LMAssert(node->type == LMMarkupNodeInstruction);
+            LMAssert(stringEquals(document, node->name, "properties"));
+
+            LMMarkupDocumentRelease(document);
+        }
+    }
+}
+
+static void testErrors(void)
+{
+    LMMarkupError error;
+    uint32_t line, column;
+
+    LMAssert(LMMarkupCompile("<root>\n  <a>\n</root>", 20, &error, &line, &column) == NULL);
+    LMAssert(error == LMMarkupErrorSyntax);
+    LMAssert(line == 3);
+
+    LMAssert(LMMarkupCompile("<root>\n  <a b=\"\xFF\"/>\n</root>", 26, &error, &line, &column) == NULL);
+    LMAssert(error == LMMarkupErrorEncoding);
+    LMAssert(line == 2 && column == 9);
+}
+
+int main(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; i++) {
+        testRoundTrip(argv[i]);
+    }
+
+    testUnknownSource();
+    testProperties();
+    testUnsupportedProperties();
+    testErrors();
+
+    return LMTestFinish("LMMarkupDocumentTests");
+}
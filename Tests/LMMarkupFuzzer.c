@@ -0,0 +1,359 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Fuzzes the markup reader, compiler, and document decoder. Built with
+// -DLM_LIBFUZZER, this provides a libFuzzer entry point; otherwise, it runs a
+// deterministic mutation loop seeded by the documents named on the command line.
+// Either way it is intended to be built with the address and undefined behavior
+// sanitizers enabled.
+
+#include "LMTest.h"
+#include "LMMarkupCompiler.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define LMFuzzCheck(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            abort(); \
+        } \
+    } while (0)
+
+static uint64_t LMFuzzTouch(LMMarkupSlice slice)
+{
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < slice.length; i++) {
+        sum += (uint8_t)slice.bytes[i];
+    }
+
+    return sum;
+}
+
+static void LMFuzzRead(const uint8_t *data, size_t size)
+{
+    LMMarkupReaderRef reader = LMMarkupReaderCreate(data, size);
+
+    LMFuzzCheck(reader != NULL);
+
+    uint64_t sum = 0;
+
+    LMMarkupTokenType type;
+
+    // Every slice must be readable in full
+    while ((type = LMMarkupReaderNext(reader)) != LMMarkupTokenEndOfDocument && type != LMMarkupTokenError) {
+        sum += LMFuzzTouch(LMMarkupReaderGetName(reader));
+
+        if (type == LMMarkupTokenInstruction) {
+            sum += LMFuzzTouch(LMMarkupReaderGetData(reader));
+        }
+
+        for (uint32_t i = 0, n = LMMarkupReaderGetAttributeCount(reader); i < n; i++) {
+            const LMMarkupReaderAttribute *attribute = LMMarkupReaderGetAttribute(reader, i);
+
+            sum += LMFuzzTouch(attribute->key) + LMFuzzTouch(attribute->value);
+        }
+    }
+
+    if (type == LMMarkupTokenError) {
+        LMFuzzCheck(LMMarkupReaderGetError(reader) != LMMarkupErrorNone);
+        LMFuzzCheck(LMMarkupReaderGetLine(reader) >= 1 && LMMarkupReaderGetColumn(reader) >= 1);
+        LMFuzzCheck(LMMarkupReaderNext(reader) == LMMarkupTokenError);
+    } else {
+        LMFuzzCheck(LMMarkupReaderGetError(reader) == LMMarkupErrorNone);
+    }
+
+    LMTestConsume(sum);
+
+    LMMarkupReaderRelease(reader);
+}
+
+static void LMFuzzCompile(const uint8_t *data, size_t size)
+{
+    LMMarkupError error;
+    uint32_t line, column;
+
+    LMMarkupDocumentRef document = LMMarkupCompile(data, size, &error, &line, &column);
+
+    if (document == NULL) {
+        LMFuzzCheck(error != LMMarkupErrorNone);
+
+        return;
+    }
+
+    LMFuzzCheck(error == LMMarkupErrorNone);
+
+    // Whatever compiles must survive encoding, decoding, and re-encoding unchanged
+    size_t length;
+    void *encoded = LMMarkupDocumentEncode(document, &length);
+
+    LMFuzzCheck(encoded != NULL);
+
+    LMMarkupDocumentRef decoded = LMMarkupDocumentDecode(encoded, length);
+
+    LMFuzzCheck(decoded != NULL);
+    LMFuzzCheck(LMMarkupDocumentMatchesSource(decoded, data, size));
+
+    size_t reencodedLength;
+    void *reencoded = LMMarkupDocumentEncode(decoded, &reencodedLength);
+
+    LMFuzzCheck(reencoded != NULL && reencodedLength == length && memcmp(reencoded, encoded, length) == 0);
+
+    free(reencoded);
+    free(encoded);
+
+    LMMarkupDocumentRelease(decoded);
+    LMMarkupDocumentRelease(document);
+}
+
+static void LMFuzzDecode(const uint8_t *data, size_t size)
+{
+    // Arbitrary input must either be rejected or decode to a document whose references are all valid
+    LMMarkupDocumentRef document = LMMarkupDocumentDecode(data, size);
+
+    if (document == NULL) {
+        return;
+    }
+
+    uint64_t sum = 0;
+
+    for (uint32_t i = 0, n = LMMarkupDocumentGetStringCount(document); i < n; i++) {
+        size_t length;
+        const char *bytes = LMMarkupDocumentGetString(document, i, &length);
+
+        LMFuzzCheck(bytes != NULL && bytes[length] == 0);
+
+        sum += length;
+    }
+
+    LMTestConsume(sum);
+
+    size_t length;
+    void *encoded = LMMarkupDocumentEncode(document, &length);
+
+    LMFuzzCheck(encoded != NULL);
+
+    free(encoded);
+
+    LMMarkupDocumentRelease(document);
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    LMFuzzRead(data, size);
+    LMFuzzCompile(data, size);
+    LMFuzzDecode(data, size);
+
+    return 0;
+}
+
+#ifndef LM_LIBFUZZER
+
+typedef struct {
+    uint8_t *bytes;
+    size_t length;
+} LMFuzzInput;
+
+static uint64_t state = 0x9E3779B97F4A7C15u;
+
+static uint64_t LMFuzzRandom(uint64_t limit)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return (limit == 0) ? 0 : state % limit;
+}
+
+// Fragments that are likely to reach interesting paths in the reader and compiler
+static const char *kFragments[] = {
+    "<", ">", "/>", "</", "=", "\"", "'", "&", ";", "&amp;", "&#x", "&#", "<!--", "-->", "<![CDATA[", "]]>",
+    "<?", "?>", "<?properties {\"a\": {\"b\": 1}}?>", "{", "}", "\\u", "\\ud83d\\ude00", "\\", ":", ",",
+    "1e400", "-0", "9223372036854775808", "\r", "\n", "\t", "\xC3", "\xC3\xA9", "\xED\xA0\x80", "\xF0\x9F\x98\x80",
+    "\xEF\xBF\xBE", "\xFF", "\0"
+};
+
+static void LMFuzzMutate(LMFuzzInput *input, const LMFuzzInput *seeds, int seedCount, uint8_t *buffer, size_t capacity)
+{
+    size_t length = input->length;
+
+    memcpy(buffer, input->bytes, length);
+
+    for (uint64_t i = 0, n = 1 + LMFuzzRandom(4); i < n; i++) {
+        size_t position = (size_t)LMFuzzRandom(length + 1);
+
+        switch (LMFuzzRandom(6)) {
+            case 0: {
+                // Flip a bit
+                if (length > 0) {
+                    buffer[position % length] ^= (uint8_t)(1 << LMFuzzRandom(8));
+                }
+
+                break;
+            }
+
+            case 1: {
+                // Insert a fragment
+                const char *fragment = kFragments[LMFuzzRandom(sizeof(kFragments) / sizeof(*kFragments))];
+
+                size_t fragmentLength = (*fragment == 0) ? 1 : strlen(fragment);
+
+                if (length + fragmentLength <= capacity) {
+                    memmove(buffer + position + fragmentLength, buffer + position, length - position);
+                    memcpy(buffer + position, fragment, fragmentLength);
+
+                    length += fragmentLength;
+                }
+
+                break;
+            }
+
+            case 2: {
+                // Delete a range
+                size_t count = (size_t)LMFuzzRandom(length - position + 1);
+
+                memmove(buffer + position, buffer + position + count, length - position - count);
+
+                length -= count;
+
+                break;
+            }
+
+            case 3: {
+                // Duplicate a range
+                size_t count = (size_t)LMFuzzRandom(length - position + 1);
+
+                if (length + count <= capacity) {
+                    memmove(buffer + position + count, buffer + position, length - position);
+
+                    length += count;
+                }
+
+                break;
+            }
+
+            case 4: {
+                // Truncate
+                length = position;
+
+                break;
+            }
+
+            default: {
+                // Splice in part of another seed
+                const LMFuzzInput *seed = &seeds[LMFuzzRandom(seedCount)];
+
+                size_t start = (size_t)LMFuzzRandom(seed->length + 1);
+                size_t count = (size_t)LMFuzzRandom(seed->length - start + 1);
+
+                if (position + count <= capacity) {
+                    memcpy(buffer + position, seed->bytes + start, count);
+
+                    if (position + count > length) {
+                        length = position + count;
+                    }
+                }
+
+                break;
+            }
+        }
+    }
+
+    input->bytes = buffer;
+    input->length = length;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *value = getenv("LM_FUZZ_ITERATIONS");
+
+    long iterations = (value == NULL) ? 20000 : atol(value);
+
+    int seedCount = argc - 1;
+
+    LMFuzzInput *seeds = calloc(seedCount + 1, sizeof(LMFuzzInput));
+
+    size_t capacity = 0;
+
+    for (int i = 0; i < seedCount; i++) {
+        seeds[i].bytes = LMTestReadFile(argv[i + 1], &seeds[i].length);
+
+        LMFuzzCheck(seeds[i].bytes != NULL);
+
+        if (seeds[i].length > capacity) {
+            capacity = seeds[i].length;
+        }
+    }
+
+    // Without seeds, mutate an empty document
+    if (seedCount == 0) {
+        seeds[0].bytes = (uint8_t *)"";
+
+        seedCount = 1;
+    }
+
+    capacity = capacity * 2 + 4096;
+
+    uint8_t *buffer = malloc(capacity);
+
+    for (int i = 0; i < seedCount; i++) {
+        LLVMFuzzerTestOneInput(seeds[i].bytes, seeds[i].length);
+    }
+
+    for (long i = 0; i < iterations; i++) {
+        LMFuzzInput input = seeds[LMFuzzRandom(seedCount)];
+
+        LMFuzzMutate(&input, seeds, seedCount, buffer, capacity);
+
+        LLVMFuzzerTestOneInput(input.bytes, input.length);
+
+        // Feed the decoder mutated binary documents as well as markup
+        LMMarkupError error;
+        uint32_t line, column;
+
+        LMMarkupDocumentRef document = LMMarkupCompile(seeds[i % seedCount].bytes, seeds[i % seedCount].length, &error, &line, &column);
+
+        if (document != NULL) {
+            size_t length;
+            void *encoded = LMMarkupDocumentEncode(document, &length);
+
+            LMFuzzInput encodedInput = {encoded, length};
+
+            LMFuzzMutate(&encodedInput, &encodedInput, 1, buffer, capacity);
+
+            LMFuzzDecode(encodedInput.bytes, encodedInput.length);
+
+            free(encoded);
+
+            LMMarkupDocumentRelease(document);
+        }
+    }
+
+    printf("LMMarkupFuzzer: %ld iterations over %d seeds\n", iterations, seedCount);
+
+    for (int i = 0; i < argc - 1; i++) {
+        free(seeds[i].bytes);
+    }
+
+    free(seeds);
+    free(buffer);
+
+    return LMTestFinish("LMMarkupFuzzer");
+}
+
+#endif
@@ -0,0 +1,93 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Measures the throughput of the markup reader, including encoding validation, over
+// the documents named on the command line.
+
+#include "LMTest.h"
+#include "LMMarkupReader.h"
+
+#include <stdlib.h>
+
+static const double kDuration = 0.5;
+
+static uint64_t readDocument(const char *bytes, size_t length)
+{
+    LMMarkupReaderRef reader = LMMarkupReaderCreate(bytes, length);
+
+    uint64_t count = 0;
+
+    LMMarkupTokenType type;
+
+    while ((type = LMMarkupReaderNext(reader)) != LMMarkupTokenEndOfDocument && type != LMMarkupTokenError) {
+        count += 1 + LMMarkupReaderGetAttributeCount(reader);
+    }
+
+    LMMarkupReaderRelease(reader);
+
+    return (type == LMMarkupTokenError) ? 0 : count;
+}
+
+int main(int argc, char *argv[])
+{
+    int count = argc - 1;
+
+    char **documents = calloc(count, sizeof(char *));
+    size_t *lengths = calloc(count, sizeof(size_t));
+
+    size_t length = 0;
+    uint64_t tokens = 0;
+
+    for (int i = 0; i < count; i++) {
+        documents[i] = LMTestReadFile(argv[i + 1], &lengths[i]);
+
+        LMAssert(documents[i] != NULL);
+
+        if (documents[i] == NULL) {
+            return LMTestFinish("LMMarkupReaderBenchmark");
+        }
+
+        uint64_t documentTokens = readDocument(documents[i], lengths[i]);
+
+        LMAssert(documentTokens > 0);
+
+        length += lengths[i];
+        tokens += documentTokens;
+    }
+
+    uint64_t passes = 0;
+
+    double start = LMTestNow(), elapsed;
+
+    do {
+        for (int i = 0; i < count; i++) {
+            LMTestConsume(readDocument(documents[i], lengths[i]));
+        }
+
+        passes++;
+    } while ((elapsed = LMTestNow() - start) < kDuration);
+
+    printf("%d documents, %zu bytes, %llu tokens and attributes\n", count, length, (unsigned long long)tokens);
+    printf("read: %10.0f documents/s %8.1f MB/s %8.1f M tokens/s\n", passes * count / elapsed,
+        passes * length / elapsed / 1e6, passes * tokens / elapsed / 1e6);
+
+    for (int i = 0; i < count; i++) {
+        free(documents[i]);
+    }
+
+    free(documents);
+    free(lengths);
+
+    return LMTestFinish("LMMarkupReaderBenchmark");
+}
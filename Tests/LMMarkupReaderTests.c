@@ -0,0 +1,209 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Tests the markup reader's tokens and error positions, and checks that every document
+// named on the command line reads without error.
+
+#include "LMTest.h"
+#include "LMMarkupReader.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static bool sliceEquals(LMMarkupSlice slice, const char *string)
+{
+    return slice.length == strlen(string) && memcmp(slice.bytes, string, slice.length) == 0;
+}
+
+static bool next(LMMarkupReaderRef reader, LMMarkupTokenType type, const char *name)
+{
+    return LMMarkupReaderNext(reader) == type && (name == NULL || sliceEquals(LMMarkupReaderGetName(reader), name));
+}
+
+static bool attributeEquals(LMMarkupReaderRef reader, uint32_t index, const char *key, const char *value)
+{
+    const LMMarkupReaderAttribute *attribute = LMMarkupReaderGetAttribute(reader, index);
+
+    return sliceEquals(attribute->key, key) && sliceEquals(attribute->value, value);
+}
+
+static void fail(const char *markup, size_t length, LMMarkupError error, uint32_t line, uint32_t column)
+{
+    LMMarkupReaderRef reader = LMMarkupReaderCreate(markup, length);
+
+    LMMarkupTokenType type;
+
+    while ((type = LMMarkupReaderNext(reader)) != LMMarkupTokenEndOfDocument && type != LMMarkupTokenError) {
+        continue;
+    }
+
+    if (type != LMMarkupTokenError || LMMarkupReaderGetError(reader) != error
+        || LMMarkupReaderGetLine(reader) != line || LMMarkupReaderGetColumn(reader) != column) {
+        fprintf(stderr, "expected error %d at %u:%u, got %d at %u:%u\n", error, line, column,
+            LMMarkupReaderGetError(reader), LMMarkupReaderGetLine(reader), LMMarkupReaderGetColumn(reader));
+
+        LMTestFailures++;
+    }
+
+    // Errors are sticky
+    LMAssert(LMMarkupReaderNext(reader) == LMMarkupTokenError);
+
+    LMMarkupReaderRelease(reader);
+}
+
+static void testTokens(void)
+{
+    static const char markup[] = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<!-- comment -->\n"
+        "<root a=\"1 &amp; &lt;&#65;&#x42;\" b='x'>\n"
+        "    <?case ios?>\n"
+        "    <child/>\n"
+        "</root>\n";
+
+    LMMarkupReaderRef reader = LMMarkupReaderCreate(markup, sizeof(markup) - 1);
+
+    LMAssert(next(reader, LMMarkupTokenStartElement, "root"));
+    LMAssert(LMMarkupReaderGetLine(reader) == 3);
+    LMAssert(LMMarkupReaderGetAttributeCount(reader) == 2);
+    LMAssert(attributeEquals(reader, 0, "a", "1 & <AB"));
+    LMAssert(attributeEquals(reader, 1, "b", "x"));
+
+    LMAssert(next(reader, LMMarkupTokenInstruction, "case"));
+    LMAssert(sliceEquals(LMMarkupReaderGetData(reader), "ios"));
+    LMAssert(LMMarkupReaderGetLine(reader) == 4);
+
+    LMAssert(next(reader, LMMarkupTokenStartElement, "child"));
+    LMAssert(LMMarkupReaderGetAttributeCount(reader) == 0);
+    LMAssert(next(reader, LMMarkupTokenEndElement, "child"));
+
+    LMAssert(next(reader, LMMarkupTokenEndElement, "root"));
+    LMAssert(LMMarkupReaderGetLine(reader) == 6);
+
+    LMAssert(next(reader, LMMarkupTokenEndOfDocument, NULL));
+    LMAssert(next(reader, LMMarkupTokenEndOfDocument, NULL));
+
+    LMAssert(LMMarkupReaderGetError(reader) == LMMarkupErrorNone);
+
+    LMMarkupReaderRelease(reader);
+}
+
+static void testLineBreaks(void)
+{
+    // Carriage returns count as line breaks, alone or followed by a line feed
+    static const char markup[] = "<root>\r\n<a/>\r<b/>\n</root>";
+
+    LMMarkupReaderRef reader = LMMarkupReaderCreate(markup, sizeof(markup) - 1);
+
+    LMAssert(next(reader, LMMarkupTokenStartElement, "root"));
+    LMAssert(next(reader, LMMarkupTokenStartElement, "a") && LMMarkupReaderGetLine(reader) == 2);
+    LMAssert(next(reader, LMMarkupTokenEndElement, "a"));
+    LMAssert(next(reader, LMMarkupTokenStartElement, "b") && LMMarkupReaderGetLine(reader) == 3);
+    LMAssert(next(reader, LMMarkupTokenEndElement, "b"));
+    LMAssert(next(reader, LMMarkupTokenEndElement, "root") && LMMarkupReaderGetLine(reader) == 4);
+
+    LMMarkupReaderRelease(reader);
+}
+
+static void testSyntaxErrors(void)
+{
+    fail("", 0, LMMarkupErrorSyntax, 1, 1);
+    fail("   ", 3, LMMarkupErrorSyntax, 1, 4);
+    fail("<a>", 3, LMMarkupErrorSyntax, 1, 4);
+    fail("<a></b>", 7, LMMarkupErrorSyntax, 1, 6);
+    fail("<a/><b/>", 8, LMMarkupErrorSyntax, 1, 5);
+    fail("<a b=\"1\" b=\"2\"/>", 16, LMMarkupErrorSyntax, 1, 10);
+    fail("<a b=\"<\"/>", 10, LMMarkupErrorSyntax, 1, 7);
+    fail("<a>\r\n<b c=\"&bogus;\"/></a>", 25, LMMarkupErrorSyntax, 2, 7);
+}
+
+static void testContentErrors(void)
+{
+    fail("<a>\n text</a>", 13, LMMarkupErrorCharacters, 2, 2);
+    fail("<a>\n<![CDATA[x]]></a>", 21, LMMarkupErrorCDATA, 2, 1);
+}
+
+static void testEncodingErrors(void)
+{
+    // Invalid bytes are reported at their own position, before any tokens are returned
+    fail("<a>\n\x01</a>", 9, LMMarkupErrorEncoding, 2, 1);
+    fail("<a>\n\xC0\xAF</a>", 10, LMMarkupErrorEncoding, 2, 1);
+    fail("<a b=\"\xED\xA0\x80\"/>", 12, LMMarkupErrorEncoding, 1, 7);
+    fail("<a b=\"\xE2\x82\"/>", 11, LMMarkupErrorEncoding, 1, 7);
+    fail("<a b=\"\xF4\x90\x80\x80\"/>", 13, LMMarkupErrorEncoding, 1, 7);
+    fail("<a b=\"\xFF\"/>", 10, LMMarkupErrorEncoding, 1, 7);
+    fail("<a/>\n\n  \xEF\xBF\xBE", 11, LMMarkupErrorEncoding, 3, 3);
+    fail("<a b=\"\0\"/>", 10, LMMarkupErrorEncoding, 1, 7);
+
+    // Well-formed multibyte characters are accepted
+    static const char markup[] = "<a b=\"caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80\"/>";
+
+    LMMarkupReaderRef reader = LMMarkupReaderCreate(markup, sizeof(markup) - 1);
+
+    LMAssert(next(reader, LMMarkupTokenStartElement, "a"));
+    LMAssert(attributeEquals(reader, 0, "b", "caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80"));
+
+    LMMarkupReaderRelease(reader);
+}
+
+static void testDocument(const char *path)
+{
+    size_t length;
+    char *bytes = LMTestReadFile(path, &length);
+
+    LMAssert(bytes != NULL);
+
+    if (bytes == NULL) {
+        return;
+    }
+
+    LMMarkupReaderRef reader = LMMarkupReaderCreate(bytes, length);
+
+    LMMarkupTokenType type;
+
+    int depth = 0;
+
+    while ((type = LMMarkupReaderNext(reader)) != LMMarkupTokenEndOfDocument && type != LMMarkupTokenError) {
+        if (type == LMMarkupTokenStartElement) {
+            depth++;
+        } else if (type == LMMarkupTokenEndElement) {
+            depth--;
+        }
+    }
+
+    if (type == LMMarkupTokenError) {
+        fprintf(stderr, "%s:%u:%u: error %d\n", path, LMMarkupReaderGetLine(reader), LMMarkupReaderGetColumn(reader), LMMarkupReaderGetError(reader));
+    }
+
+    LMAssert(type == LMMarkupTokenEndOfDocument);
+    LMAssert(depth == 0);
+
+    LMMarkupReaderRelease(reader);
+
+    free(bytes);
+}
+
+int main(int argc, char *argv[])
+{
+    testTokens();
+    testLineBreaks();
+    testSyntaxErrors();
+    testContentErrors();
+    testEncodingErrors();
+
+    for (int i = 1; i < argc; i++) {
+        testDocument(argv[i]);
+    }
+
+    return LMTestFinish("LMMarkupReaderTests");
+}
@@ -0,0 +1,199 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Measures the cost of parsing color and font values, using the values that appear
+// in the documents named on the command line as well as one of each font form.
+
+#include "LMTest.h"
+#include "LMMarkupReader.h"
+#include "LMMarkupValue.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    char **values;
+    size_t *lengths;
+    uint32_t count;
+    uint32_t capacity;
+} LMValueList;
+
+static const double kDuration = 0.25;
+
+// Minimum number of values parsed between reads of the clock
+static const uint32_t kBatchSize = 1024;
+
+static void addValue(LMValueList *list, const char *bytes, size_t length)
+{
+    if (list->count == list->capacity) {
+        list->capacity = (list->capacity == 0) ? 64 : list->capacity * 2;
+
+        list->values = realloc(list->values, list->capacity * sizeof(char *));
+        list->lengths = realloc(list->lengths, list->capacity * sizeof(size_t));
+    }
+
+    list->values[list->count] = malloc(length + 1);
+
+    memcpy(list->values[list->count], bytes, length);
+
+    list->values[list->count][length] = 0;
+    list->lengths[list->count] = length;
+
+    list->count++;
+}
+
+static void freeValues(LMValueList *list)
+{
+    for (uint32_t i = 0; i < list->count; i++) {
+        free(list->values[i]);
+    }
+
+    free(list->values);
+    free(list->lengths);
+}
+
+static bool hasSuffix(LMMarkupSlice slice, const char *suffix)
+{
+    size_t length = strlen(suffix);
+
+    // The first character of the suffix may be either case, as in "font" and "titleFont"
+    return slice.length >= length
+        && (slice.bytes[slice.length - length] | 0x20) == suffix[0]
+        && memcmp(slice.bytes + slice.length - length + 1, suffix + 1, length - 1) == 0;
+}
+
+static void collectValues(const char *path, LMValueList *colors, LMValueList *fonts)
+{
+    size_t length;
+    char *bytes = LMTestReadFile(path, &length);
+
+    LMAssert(bytes != NULL);
+
+    if (bytes == NULL) {
+        return;
+    }
+
+    LMMarkupReaderRef reader = LMMarkupReaderCreate(bytes, length);
+
+    LMMarkupTokenType type;
+
+    while ((type = LMMarkupReaderNext(reader)) != LMMarkupTokenEndOfDocument && type != LMMarkupTokenError) {
+        for (uint32_t i = 0, n = LMMarkupReaderGetAttributeCount(reader); i < n; i++) {
+            const LMMarkupReaderAttribute *attribute = LMMarkupReaderGetAttribute(reader, i);
+
+            if (hasSuffix(attribute->key, "color") && attribute->value.length > 0 && attribute->value.bytes[0] == '#') {
+                addValue(colors, attribute->value.bytes, attribute->value.length);
+            } else if (hasSuffix(attribute->key, "font")) {
+                addValue(fonts, attribute->value.bytes, attribute->value.length);
+            }
+        }
+    }
+
+    LMMarkupReaderRelease(reader);
+
+    free(bytes);
+}
+
+static void measureColors(const char *name, LMValueList *list)
+{
+    if (list->count == 0) {
+        return;
+    }
+
+    uint32_t repetitions = (list->count < kBatchSize) ? kBatchSize / list->count : 1;
+
+    uint64_t passes = 0, sum = 0;
+
+    double start = LMTestNow(), elapsed;
+
+    do {
+        for (uint32_t j = 0; j < repetitions; j++) {
+            for (uint32_t i = 0; i < list->count; i++) {
+                uint8_t components[4];
+
+                sum += LMMarkupParseColor(list->values[i], list->lengths[i], components) ? components[0] : 0;
+            }
+        }
+
+        passes += repetitions;
+    } while ((elapsed = LMTestNow() - start) < kDuration);
+
+    LMTestConsume(sum);
+
+    printf("%-32s %5u values %8.1f ns/value\n", name, list->count, elapsed * 1e9 / (passes * list->count));
+}
+
+static void measureFonts(const char *name, LMValueList *list)
+{
+    if (list->count == 0) {
+        return;
+    }
+
+    uint32_t repetitions = (list->count < kBatchSize) ? kBatchSize / list->count : 1;
+
+    uint64_t passes = 0, sum = 0;
+
+    double start = LMTestNow(), elapsed;
+
+    do {
+        for (uint32_t j = 0; j < repetitions; j++) {
+            for (uint32_t i = 0; i < list->count; i++) {
+                LMMarkupFont font;
+
+                sum += LMMarkupParseFont(list->values[i], list->lengths[i], &font) ? font.type : 0;
+            }
+        }
+
+        passes += repetitions;
+    } while ((elapsed = LMTestNow() - start) < kDuration);
+
+    LMTestConsume(sum);
+
+    printf("%-32s %5u values %8.1f ns/value\n", name, list->count, elapsed * 1e9 / (passes * list->count));
+}
+
+int main(int argc, char *argv[])
+{
+    LMValueList colors = {0}, fonts = {0};
+
+    for (int i = 1; i < argc; i++) {
+        collectValues(argv[i], &colors, &fonts);
+    }
+
+    measureColors("colors (documents)", &colors);
+    measureFonts("fonts (documents)", &fonts);
+
+    static const char *fontValues[] = {
+        "title1", "caption2", "System 17", "System-Bold 15.5", "System-Italic 12", "HelveticaNeue-Medium 24"
+    };
+
+    for (size_t i = 0; i < sizeof(fontValues) / sizeof(*fontValues); i++) {
+        LMValueList list = {0};
+
+        addValue(&list, fontValues[i], strlen(fontValues[i]));
+
+        char name[40];
+
+        snprintf(name, sizeof(name), "\"%.30s\"", fontValues[i]);
+
+        measureFonts(name, &list);
+
+        freeValues(&list);
+    }
+
+    freeValues(&colors);
+    freeValues(&fonts);
+
+    return LMTestFinish("LMMarkupValueBenchmark");
+}
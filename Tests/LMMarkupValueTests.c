@@ -0,0 +1,128 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Tests the parsing of color and font values.
+
+#include "LMTest.h"
+#include "LMMarkupValue.h"
+
+#include <string.h>
+
+static bool parseColor(const char *value, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+{
+    uint8_t components[4];
+
+    return LMMarkupParseColor(value, strlen(value), components)
+        && components[0] == red && components[1] == green && components[2] == blue && components[3] == alpha;
+}
+
+static bool parseFont(const char *value, LMMarkupFont *font)
+{
+    memset(font, 0xFF, sizeof(LMMarkupFont));
+
+    return LMMarkupParseFont(value, strlen(value), font);
+}
+
+static void testColors(void)
+{
+    LMAssert(parseColor("#f80", 0xFF, 0x88, 0x00, 0xFF));
+    LMAssert(parseColor("#0c47a7", 0x0C, 0x47, 0xA7, 0xFF));
+    LMAssert(parseColor("#0C47A7", 0x0C, 0x47, 0xA7, 0xFF));
+    LMAssert(parseColor("#ffffff80", 0xFF, 0xFF, 0xFF, 0x80));
+    LMAssert(parseColor("#00000000", 0x00, 0x00, 0x00, 0x00));
+
+    static const char *invalid[] = {
+        "", "#", "#f", "#ff", "#ffff", "#fffff", "#fffffff", "#fffffffff", "#ggg", "#0c47a", "0c47a7", "#0c47 7", "red"
+    };
+
+    uint8_t components[4];
+
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(*invalid); i++) {
+        LMAssert(!LMMarkupParseColor(invalid[i], strlen(invalid[i]), components));
+    }
+
+    // Only the given number of characters is read
+    LMAssert(LMMarkupParseColor("#f80f80", 4, components) && components[0] == 0xFF && components[2] == 0x00);
+}
+
+static void testTextStyles(void)
+{
+    static const char *textStyles[] = {
+        "title1", "title2", "title3", "headline", "subheadline", "body", "callout", "footnote", "caption1", "caption2"
+    };
+
+    LMMarkupFont font;
+
+    for (size_t i = 0; i < sizeof(textStyles) / sizeof(*textStyles); i++) {
+        LMAssert(parseFont(textStyles[i], &font));
+        LMAssert(font.type == LMMarkupFontTextStyle);
+        LMAssert(font.textStyle == (LMMarkupTextStyle)i);
+    }
+
+    // Text style names are case-sensitive, and other single words are not fonts
+    LMAssert(!parseFont("Body", &font));
+    LMAssert(!parseFont("title", &font));
+    LMAssert(!parseFont("Helvetica", &font));
+    LMAssert(!parseFont("", &font));
+}
+
+static void testSystemFonts(void)
+{
+    LMMarkupFont font;
+
+    LMAssert(parseFont("System 12", &font));
+    LMAssert(font.type == LMMarkupFontSystem && font.size == 12);
+
+    LMAssert(parseFont("System-Bold 15.5", &font));
+    LMAssert(font.type == LMMarkupFontBoldSystem && font.size == 15.5);
+
+    LMAssert(parseFont("System-Italic 1.5e1", &font));
+    LMAssert(font.type == LMMarkupFontItalicSystem && font.size == 15);
+
+    // Other weights are treated as named fonts
+    LMAssert(parseFont("System-Light 12", &font));
+    LMAssert(font.type == LMMarkupFontNamed && font.nameLength == 12);
+}
+
+static void testNamedFonts(void)
+{
+    LMMarkupFont font;
+
+    LMAssert(parseFont("Helvetica 24", &font));
+    LMAssert(font.type == LMMarkupFontNamed && font.nameLength == 9 && font.size == 24);
+
+    LMAssert(parseFont("HelveticaNeue-MediumItalic .5", &font));
+    LMAssert(font.type == LMMarkupFontNamed && font.nameLength == 26 && font.size == 0.5);
+
+    // Sizes are read like -[NSString floatValue]: trailing characters are ignored, and
+    // values without a leading number are zero
+    LMAssert(parseFont("Helvetica 18pt", &font) && font.size == 18);
+    LMAssert(parseFont("Helvetica large", &font) && font.size == 0);
+    LMAssert(parseFont("Helvetica -3", &font) && font.size == -3);
+    LMAssert(parseFont("Helvetica 1e", &font) && font.size == 1);
+
+    // A font specification must have exactly two components
+    LMAssert(!parseFont("Helvetica Neue 18", &font));
+    LMAssert(!parseFont("Helvetica  18", &font));
+}
+
+int main(void)
+{
+    testColors();
+    testTextStyles();
+    testSystemFonts();
+    testNamedFonts();
+
+    return LMTestFinish("LMMarkupValueTests");
+}
@@ -0,0 +1,81 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "LMTest.h"
+
+#include <stdlib.h>
+#include <time.h>
+
+int LMTestFailures = 0;
+
+static volatile uint64_t sink;
+
+void *LMTestReadFile(const char *path, size_t *length)
+{
+    FILE *file = fopen(path, "rb");
+
+    if (file == NULL) {
+        return NULL;
+    }
+
+    char *bytes = NULL;
+
+    if (fseek(file, 0, SEEK_END) == 0) {
+        long size = ftell(file);
+
+        if (size >= 0 && fseek(file, 0, SEEK_SET) == 0) {
+            // Allocate at least one byte so that empty files are distinguishable from errors
+            bytes = malloc((size_t)size + 1);
+
+            if (bytes != NULL && fread(bytes, 1, (size_t)size, file) != (size_t)size) {
+                free(bytes);
+
+                bytes = NULL;
+            }
+
+            *length = (size_t)size;
+        }
+    }
+
+    fclose(file);
+
+    return bytes;
+}
+
+double LMTestNow(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
+
+int LMTestFinish(const char *name)
+{
+    if (LMTestFailures > 0) {
+        fprintf(stderr, "%s: %d failure(s)\n", name, LMTestFailures);
+
+        return 1;
+    }
+
+    printf("%s: passed\n", name);
+
+    return 0;
+}
+
+void LMTestConsume(uint64_t value)
+{
+    sink += value;
+}
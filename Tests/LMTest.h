@@ -0,0 +1,69 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef LMTest_h
+#define LMTest_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * The number of failed assertions.
+ */
+extern int LMTestFailures;
+
+/**
+ * Records a failure if a condition does not hold.
+ */
+#define LMAssert(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: assertion failed: %s\n", __FILE__, __LINE__, #condition); \
+            LMTestFailures++; \
+        } \
+    } while (0)
+
+/**
+ * Reads a file into memory.
+ *
+ * @param path The path to the file.
+ * @param length On return, the length of the file in bytes.
+ *
+ * @return The contents of the file, which the caller must free, or <code>NULL</code> if the
+ * file could not be read.
+ */
+void *LMTestReadFile(const char *path, size_t *length);
+
+/**
+ * Returns the current value of a monotonic clock, in seconds.
+ */
+double LMTestNow(void);
+
+/**
+ * Reports the result of a test run.
+ *
+ * @param name The name of the test suite.
+ *
+ * @return The process exit status.
+ */
+int LMTestFinish(const char *name);
+
+/**
+ * Prevents the compiler from discarding a benchmarked result.
+ */
+void LMTestConsume(uint64_t value);
+
+#endif
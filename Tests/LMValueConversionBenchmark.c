@@ -0,0 +1,349 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Breaks down the cost of the property values applied when a document is loaded:
+// every attribute, plus every property of each template named by a "class" attribute.
+// Each key path is classified by its suffix as a color, font, image, or other value,
+// and color and font values are then parsed. Classification is measured per property
+// and per interned key; parsing is measured per property and memoized by interned
+// value. Images are classified but not loaded.
+
+#include "LMTest.h"
+#include "LMMarkupCompiler.h"
+#include "LMMarkupValue.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum {
+    LMValueUnclassified = 0,
+    LMValueDefault,
+    LMValueColor,
+    LMValueFont,
+    LMValueImage
+} LMValueType;
+
+// Property applied to a view; values that are not strings have no value index
+typedef struct {
+    uint32_t key;
+    uint32_t value;
+} LMApplication;
+
+// Parsed value, memoized by value index
+typedef struct {
+    bool parsed;
+    bool valid;
+    union {
+        uint8_t components[4];
+        LMMarkupFont font;
+    };
+} LMConvertedValue;
+
+static const double kDuration = 0.5;
+
+static bool hasSuffix(const char *bytes, size_t length, const char *suffix)
+{
+    size_t suffixLength = strlen(suffix);
+
+    return length >= suffixLength && memcmp(bytes + length - suffixLength, suffix, suffixLength) == 0;
+}
+
+static LMValueType classify(LMMarkupDocumentRef document, uint32_t key)
+{
+    size_t length;
+    const char *bytes = LMMarkupDocumentGetString(document, key, &length);
+
+    if (hasSuffix(bytes, length, "Color") || hasSuffix(bytes, length, "color")) {
+        return LMValueColor;
+    } else if (hasSuffix(bytes, length, "Font") || hasSuffix(bytes, length, "font")) {
+        return LMValueFont;
+    } else if (hasSuffix(bytes, length, "Image") || hasSuffix(bytes, length, "image")) {
+        return LMValueImage;
+    } else {
+        return LMValueDefault;
+    }
+}
+
+static uint64_t convert(LMMarkupDocumentRef document, LMValueType type, uint32_t value, LMConvertedValue *result)
+{
+    if (value == LMMarkupNone) {
+        return 0;
+    }
+
+    size_t length;
+    const char *bytes = LMMarkupDocumentGetString(document, value, &length);
+
+    switch (type) {
+        case LMValueColor: {
+            result->valid = LMMarkupParseColor(bytes, length, result->components);
+
+            return result->valid ? result->components[0] : 0;
+        }
+
+        case LMValueFont: {
+            result->valid = LMMarkupParseFont(bytes, length, &result->font);
+
+            return result->valid ? result->font.type : 0;
+        }
+
+        default: {
+            return 0;
+        }
+    }
+}
+
+static const LMMarkupTemplate *findTemplate(LMMarkupDocumentRef document, const char *name, size_t length)
+{
+    // The last definition of a template takes precedence
+    const LMMarkupTemplate *result = NULL;
+
+    for (uint32_t i = 0, n = LMMarkupDocumentGetNodeCount(document); i < n; i++) {
+        const LMMarkupNode *node = LMMarkupDocumentGetNode(document, i);
+
+        if (node->type != LMMarkupNodeProperties) {
+            continue;
+        }
+
+        for (uint32_t j = 0; j < node->count; j++) {
+            const LMMarkupTemplate *template = LMMarkupDocumentGetTemplate(document, node->first + j);
+
+            size_t templateNameLength;
+            const char *templateName = LMMarkupDocumentGetString(document, template->name, &templateNameLength);
+
+            if (templateNameLength == length && memcmp(templateName, name, length) == 0) {
+                result = template;
+            }
+        }
+    }
+
+    return result;
+}
+
+static LMApplication *collectApplications(LMMarkupDocumentRef document, uint32_t *count, uint32_t *templateCount)
+{
+    uint32_t capacity = 256;
+
+    LMApplication *applications = malloc(capacity * sizeof(LMApplication));
+
+    *count = 0;
+    *templateCount = 0;
+
+    for (uint32_t i = 0, n = LMMarkupDocumentGetNodeCount(document); i < n; i++) {
+        const LMMarkupNode *node = LMMarkupDocumentGetNode(document, i);
+
+        if (node->type != LMMarkupNodeStartElement) {
+            continue;
+        }
+
+        for (uint32_t j = 0; j < node->count; j++) {
+            const LMMarkupAttribute *attribute = LMMarkupDocumentGetAttribute(document, node->first + j);
+
+            size_t keyLength, valueLength;
+            const char *key = LMMarkupDocumentGetString(document, attribute->key, &keyLength);
+            const char *value = LMMarkupDocumentGetString(document, attribute->value, &valueLength);
+
+            if (keyLength == 5 && memcmp(key, "class", 5) == 0) {
+                // Apply each named template's properties
+                const char *end = value + valueLength;
+
+                while (value < end) {
+                    while (value < end && *value == ' ') {
+                        value++;
+                    }
+
+                    const char *comma = memchr(value, ',', end - value);
+                    const char *nameEnd = (comma == NULL) ? end : comma;
+
+                    const LMMarkupTemplate *template = findTemplate(document, value, nameEnd - value);
+
+                    if (template != NULL) {
+                        for (uint32_t k = 0; k < template->count; k++) {
+                            const LMMarkupProperty *property = LMMarkupDocumentGetProperty(document, template->first + k);
+
+                            if (*count + 1 > capacity) {
+                                capacity *= 2;
+
+                                applications = realloc(applications, capacity * sizeof(LMApplication));
+                            }
+
+                            applications[(*count)++] = (LMApplication){property->key,
+                                (property->type == LMMarkupValueString) ? property->string : LMMarkupNone};
+
+                            (*templateCount)++;
+                        }
+                    }
+
+                    value = (comma == NULL) ? end : comma + 1;
+                }
+            } else {
+                if (*count + 1 > capacity) {
+                    capacity *= 2;
+
+                    applications = realloc(applications, capacity * sizeof(LMApplication));
+                }
+
+                applications[(*count)++] = (LMApplication){attribute->key, attribute->value};
+            }
+        }
+    }
+
+    return applications;
+}
+
+int main(int argc, char *argv[])
+{
+    for (int argument = 1; argument < argc; argument++) {
+        size_t length;
+        char *bytes = LMTestReadFile(argv[argument], &length);
+
+        LMAssert(bytes != NULL);
+
+        if (bytes == NULL) {
+            continue;
+        }
+
+        LMMarkupError error;
+        uint32_t line, column;
+
+        LMMarkupDocumentRef document = LMMarkupCompile(bytes, length, &error, &line, &column);
+
+        free(bytes);
+
+        LMAssert(document != NULL);
+
+        if (document == NULL) {
+            continue;
+        }
+
+        uint32_t count, templateCount;
+        LMApplication *applications = collectApplications(document, &count, &templateCount);
+
+        uint32_t stringCount = LMMarkupDocumentGetStringCount(document);
+
+        uint8_t *keyTypes = calloc(stringCount, sizeof(uint8_t));
+        LMConvertedValue *values = calloc(stringCount, sizeof(LMConvertedValue));
+
+        uint32_t colors = 0, fonts = 0, distinctValues = 0;
+
+        for (uint32_t i = 0; i < count; i++) {
+            LMValueType type = classify(document, applications[i].key);
+
+            if ((type == LMValueColor || type == LMValueFont) && applications[i].value != LMMarkupNone) {
+                colors += (type == LMValueColor);
+                fonts += (type == LMValueFont);
+
+                if (!values[applications[i].value].parsed) {
+                    values[applications[i].value].parsed = true;
+
+                    distinctValues++;
+                }
+            }
+        }
+
+        printf("%s\n", argv[argument]);
+        printf("%u properties (%u from templates), %u colors, %u fonts, %u distinct color and font values\n",
+            count, templateCount, colors, fonts, distinctValues);
+
+        // Classification, then conversion, then both, each per property and memoized
+        static const char *names[] = {
+            "classify per property", "classify per key",
+            "convert per property", "convert per value",
+            "total per property", "total memoized"
+        };
+
+        double results[6];
+
+        for (int strategy = 0; strategy < 6; strategy++) {
+            bool classifyOnce = (strategy % 2 == 1);
+            bool convertOnce = (strategy % 2 == 1);
+            bool shouldConvert = (strategy >= 2);
+
+            uint64_t passes = 0, sum = 0;
+
+            double start = LMTestNow(), elapsed;
+
+            do {
+                // Each pass represents a load of the document, so memoized results start empty
+                memset(keyTypes, 0, stringCount * sizeof(uint8_t));
+                memset(values, 0, stringCount * sizeof(LMConvertedValue));
+
+                for (uint32_t i = 0; i < count; i++) {
+                    const LMApplication *application = &applications[i];
+
+                    LMValueType type;
+
+                    if (classifyOnce) {
+                        type = keyTypes[application->key];
+
+                        if (type == LMValueUnclassified) {
+                            type = classify(document, application->key);
+
+                            keyTypes[application->key] = type;
+                        }
+                    } else {
+                        type = classify(document, application->key);
+                    }
+
+                    if (!shouldConvert || (type != LMValueColor && type != LMValueFont) || application->value == LMMarkupNone) {
+                        sum += type;
+
+                        continue;
+                    }
+
+                    if (convertOnce) {
+                        LMConvertedValue *value = &values[application->value];
+
+                        if (!value->parsed) {
+                            convert(document, type, application->value, value);
+
+                            value->parsed = true;
+                        }
+
+                        sum += value->valid ? value->components[0] : 0;
+                    } else {
+                        LMConvertedValue value;
+
+                        sum += convert(document, type, application->value, &value);
+                    }
+                }
+
+                passes++;
+            } while ((elapsed = LMTestNow() - start) < kDuration);
+
+            LMTestConsume(sum);
+
+            results[strategy] = elapsed * 1e6 / passes;
+
+            // Conversion costs exclude classification, which is measured separately
+            double cost = results[strategy];
+
+            if (strategy == 2 || strategy == 3) {
+                cost -= results[strategy - 2];
+            }
+
+            printf("%-24s %8.2f us/load %8.2f ns/property\n", names[strategy], cost, cost * 1e3 / count);
+        }
+
+        printf("memoization saves %.0f%% of the cost of classifying and converting values\n",
+            100 * (1 - results[5] / results[4]));
+
+        free(keyTypes);
+        free(values);
+        free(applications);
+
+        LMMarkupDocumentRelease(document);
+    }
+
+    return LMTestFinish("LMValueConversionBenchmark");
+}
@@ -0,0 +1,56 @@
+# Compiles the markup documents copied into a target's resources to .mkb files. Add
+# as a Run Script build phase after "Copy Bundle Resources", for example:
+#
+#   "${SRCROOT}/../Tools/compile-markup.sh"
+#
+# By default, every .xml file in the bundle is compiled; files that are not markup
+# documents (such as other XML resources) are skipped with a warning. To compile only
+# specific documents, set MARKUP_DOCUMENTS to a space-separated list of paths relative
+# to the bundle's resources, for example "ViewController.xml en.lproj/DetailView.xml".
+#
+# The compiler is built from the MarkupKit sources on first use. Compiled documents
+# record the length and hash of their markup, so a stale .mkb is never loaded in
+# place of an edited .xml file.
+
+set -e
+
+TOOLS=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(dirname "$TOOLS")
+
+MARKUPC=${MARKUPC:-$ROOT/build/markupc}
+
+if [ ! -x "$MARKUPC" ]; then
+    env -u SDKROOT make -C "$ROOT" markupc
+fi
+
+RESOURCES=${TARGET_BUILD_DIR}/${UNLOCALIZED_RESOURCES_FOLDER_PATH}
+
+# Determines whether a document has not been compiled since it was last modified
+stale() {
+    [ ! -e "${1%.xml}.mkb" ] || [ "$1" -nt "${1%.xml}.mkb" ]
+}
+
+compile() {
+    FILE=$1
+
+    if stale "$FILE"; then
+        if ! MESSAGE=$("$MARKUPC" "$FILE" 2>&1); then
+            echo "warning: $FILE was not compiled (${MESSAGE##*error: })"
+        fi
+    fi
+}
+
+if [ -n "$MARKUP_DOCUMENTS" ]; then
+    for DOCUMENT in $MARKUP_DOCUMENTS; do
+        FILE="$RESOURCES/$DOCUMENT"
+
+        # Listed documents must compile
+        if stale "$FILE"; then
+            "$MARKUPC" "$FILE"
+        fi
+    done
+else
+    find "$RESOURCES" -name '*.xml' | while read -r FILE; do
+        compile "$FILE"
+    done
+fi
@@ -0,0 +1,190 @@
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Compiles a markup document to the binary form loaded by LMViewBuilder.
+//
+// Usage: markupc input.xml [output.mkb]
+//
+// The output defaults to the input path with its extension replaced by ".mkb".
+
+#include "LMMarkupCompiler.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *LMMarkupErrorMessage(LMMarkupError error)
+{
+    switch (error) {
+        case LMMarkupErrorCharacters: {
+            return "unexpected character content";
+        }
+
+        case LMMarkupErrorCDATA: {
+            return "unexpected CDATA content";
+        }
+
+        case LMMarkupErrorMemory: {
+            return "out of memory";
+        }
+
+        case LMMarkupErrorEncoding: {
+            return "invalid character";
+        }
+
+        default: {
+            return "parse error";
+        }
+    }
+}
+
+static void *LMReadFile(const char *path, size_t *length)
+{
+    FILE *file = fopen(path, "rb");
+
+    if (file == NULL) {
+        return NULL;
+    }
+
+    char *bytes = NULL;
+    size_t capacity = 0;
+
+    *length = 0;
+
+    for (;;) {
+        if (capacity - *length < 4096) {
+            capacity = (capacity == 0) ? 65536 : capacity * 2;
+
+            char *buffer = realloc(bytes, capacity);
+
+            if (buffer == NULL) {
+                free(bytes);
+
+                bytes = NULL;
+
+                break;
+            }
+
+            bytes = buffer;
+        }
+
+        size_t count = fread(bytes + *length, 1, capacity - *length, file);
+
+        *length += count;
+
+        if (count == 0) {
+            if (ferror(file)) {
+                free(bytes);
+
+                bytes = NULL;
+            }
+
+            break;
+        }
+    }
+
+    // Preserve the reason for a failed read
+    int error = errno;
+
+    fclose(file);
+
+    errno = error;
+
+    return bytes;
+}
+
+static char *LMOutputPath(const char *input)
+{
+    const char *slash = strrchr(input, '/');
+    const char *dot = strrchr(input, '.');
+
+    size_t length = (dot != NULL && (slash == NULL || dot > slash)) ? (size_t)(dot - input) : strlen(input);
+
+    char *output = malloc(length + 5);
+
+    if (output != NULL) {
+        memcpy(output, input, length);
+        memcpy(output + length, ".mkb", 5);
+    }
+
+    return output;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "usage: markupc input.xml [output.mkb]\n");
+
+        return 2;
+    }
+
+    const char *input = argv[1];
+
+    size_t length;
+    void *bytes = LMReadFile(input, &length);
+
+    if (bytes == NULL) {
+        fprintf(stderr, "%s: error: unable to read file: %s\n", input, strerror(errno));
+
+        return 1;
+    }
+
+    LMMarkupError error;
+    uint32_t line, column;
+
+    LMMarkupDocumentRef document = LMMarkupCompile(bytes, length, &error, &line, &column);
+
+    free(bytes);
+
+    if (document == NULL) {
+        fprintf(stderr, "%s:%u:%u: error: %s\n", input, line, column, LMMarkupErrorMessage(error));
+
+        return 1;
+    }
+
+    size_t encodedLength;
+    void *encoded = LMMarkupDocumentEncode(document, &encodedLength);
+
+    LMMarkupDocumentRelease(document);
+
+    if (encoded == NULL) {
+        fprintf(stderr, "%s: error: unable to encode document\n", input);
+
+        return 1;
+    }
+
+    char *output = (argc == 3) ? strdup(argv[2]) : LMOutputPath(input);
+
+    FILE *file = (output == NULL) ? NULL : fopen(output, "wb");
+
+    int status = 0;
+
+    if (file == NULL || fwrite(encoded, 1, encodedLength, file) != encodedLength) {
+        perror((output == NULL) ? input : output);
+
+        status = 1;
+    }
+
+    if (file != NULL && fclose(file) != 0) {
+        perror(output);
+
+        status = 1;
+    }
+
+    free(output);
+    free(encoded);
+
+    return status;
+}